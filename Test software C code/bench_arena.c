@@ -0,0 +1,312 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "ntt.h"
+#include "pack.h"
+#include "poly_arena.h"
+#include "kyber_params.h"
+
+// Per-request latency of a Kyber-style matrix-vector product (t = A o NTT(s), then
+// 12-bit encoding of t) in three configurations:
+//   baseline - the path before the arena: every buffer allocated and freed per request,
+//              and every transform rebuilds its twiddles in a zetas[n/2] VLA
+//   heap     - per-request aligned_alloc/free, twiddles from the cached table
+//   arena    - everything bump-allocated from the thread arena, reset per request,
+//              twiddles from the cached table
+// Only the accumulator t is cleared, in every mode; the rest is overwritten by the
+// request. All modes use the same random inputs and must produce the same encodings.
+// baseline -> heap is the twiddle-cache gain, heap -> arena the allocator gain; both
+// are printed per k. The single-transform latency of both twiddle paths comes first.
+//
+// usage: bench_arena [hugepages]
+
+#define REQUESTS 20000
+#define WARMUP   200
+
+enum { MODE_BASELINE, MODE_HEAP, MODE_ARENA };
+static const char *mode_names[] = {"baseline", "heap", "arena"};
+
+static uint64_t heap_allocs;
+
+// small xorshift generator so runs are reproducible
+static uint32_t rng_state;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void random_poly(uint16_t *a) {
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = rng() % Q;
+}
+
+// poly is POLY_ARENA_ALIGN aligned, which malloc/calloc do not guarantee
+static void *heap_alloc(size_t bytes) {
+    heap_allocs++;
+    return aligned_alloc(POLY_ARENA_ALIGN, (bytes + POLY_ARENA_ALIGN - 1) & ~(size_t)(POLY_ARENA_ALIGN - 1));
+}
+
+// t_i = sum_j A_ij o s_j, coefficient-wise in the NTT domain
+static void matvec(polyvec *t, const polymat *A, const polyvec *s) {
+    for (int i = 0; i < A->k; i++) {
+        uint16_t *ti = t->vec[i].coeffs;
+        for (int j = 0; j < A->l; j++) {
+            const uint16_t *aij = polymat_at(A, i, j)->coeffs;
+            const uint16_t *sj = s->vec[j].coeffs;
+            for (int c = 0; c < KYBER_POL_LENGTH; c++)
+                ti[c] = mod_add(ti[c], mod_mul(aij[c], sj[c]));
+        }
+    }
+}
+
+// ntt_standard as it was before the cached twiddle table: twiddles rebuilt with
+// mod_pow into a stack VLA on every call
+static void ntt_uncached(uint16_t *a, int n, uint16_t omega) {
+    int log_n = 0;
+    for (int temp = n; temp > 1; temp >>= 1) log_n++;
+
+    uint16_t zetas[n / 2];
+    for (int i = 0; i < n / 2; i++) zetas[i] = mod_pow(omega, bit_reverse(i, log_n - 1));
+
+    for (int len = n / 2; len >= 1; len >>= 1) {
+        int step = n / (2 * len);
+        for (int start = 0; start < n; start += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                uint16_t u = a[start + j];
+                uint16_t v = mod_mul(a[start + j + len], zetas[j * step]);
+                a[start + j] = mod_add(u, v);
+                a[start + j + len] = mod_sub(u, v);
+            }
+        }
+    }
+}
+
+static void compute(polyvec *t, const polymat *A, polyvec *s, uint8_t *out, int k, int uncached) {
+    for (int j = 0; j < k; j++) {
+        if (uncached)
+            ntt_uncached(s->vec[j].coeffs, KYBER_POL_LENGTH, 910);
+        else
+            ntt_standard(s->vec[j].coeffs, KYBER_POL_LENGTH, 910);
+    }
+    matvec(t, A, s);
+    for (int i = 0; i < k; i++) poly_tobytes(out + i * KYBER_POLYBYTES, t->vec[i].coeffs);
+}
+
+static uint32_t checksum(const uint8_t *buf, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) h = (h ^ buf[i]) * 16777619u;
+    return h;
+}
+
+// one request, returns a checksum of the encoded result
+static uint32_t request_heap(int k, int uncached) {
+    polymat A;
+    polyvec s, t;
+    uint8_t *out;
+    uint32_t h;
+
+    A.k = A.l = k;
+    s.k = t.k = k;
+    A.rows = heap_alloc((size_t)k * k * sizeof(poly));
+    s.vec = heap_alloc((size_t)k * sizeof(poly));
+    t.vec = heap_alloc((size_t)k * sizeof(poly));
+    out = heap_alloc((size_t)k * KYBER_POLYBYTES);
+    if (!A.rows || !s.vec || !t.vec || !out) return 0;
+
+    for (int i = 0; i < k * k; i++) random_poly(A.rows[i].coeffs);
+    for (int i = 0; i < k; i++) random_poly(s.vec[i].coeffs);
+    polyvec_zero(&t);
+
+    compute(&t, &A, &s, out, k, uncached);
+    h = checksum(out, (size_t)k * KYBER_POLYBYTES);
+
+    free(out);
+    free(t.vec);
+    free(s.vec);
+    free(A.rows);
+    return h;
+}
+
+static uint32_t request_arena(poly_arena *arena, int k) {
+    polymat A;
+    polyvec s, t;
+    uint8_t *out;
+    uint32_t h;
+
+    if (polymat_alloc(&A, arena, k, k) != 0 || polyvec_alloc(&s, arena, k) != 0 ||
+        polyvec_alloc(&t, arena, k) != 0)
+        return 0;
+    out = poly_arena_alloc(arena, (size_t)k * KYBER_POLYBYTES);
+    if (!out) return 0;
+
+    for (int i = 0; i < k * k; i++) random_poly(A.rows[i].coeffs);
+    for (int i = 0; i < k; i++) random_poly(s.vec[i].coeffs);
+    polyvec_zero(&t);
+
+    compute(&t, &A, &s, out, k, 0);
+    h = checksum(out, (size_t)k * KYBER_POLYBYTES);
+
+    poly_arena_reset(arena);
+    return h;
+}
+
+static double elapsed_ns(struct timespec t0, struct timespec t1) {
+    return (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, int count, double p) {
+    int idx = (int)(p / 100.0 * (count - 1) + 0.5);
+    return sorted[idx];
+}
+
+// runs REQUESTS requests, prints percentiles, stores the median in *p50 and returns
+// a checksum over all results
+static uint32_t run(int mode, poly_arena *arena, int k, double *lat, double *p50) {
+    struct timespec t0, t1;
+    uint32_t h = 0;
+    uint64_t heap_before = heap_allocs, arena_before = arena->allocs;
+
+    rng_state = 0x12345678;
+    for (int r = 0; r < WARMUP + REQUESTS; r++) {
+        uint32_t hr;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        hr = (mode == MODE_ARENA) ? request_arena(arena, k) : request_heap(k, mode == MODE_BASELINE);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (r >= WARMUP) lat[r - WARMUP] = elapsed_ns(t0, t1);
+        h = h * 31 + hr;
+    }
+
+    qsort(lat, REQUESTS, sizeof(double), cmp_double);
+    *p50 = percentile(lat, REQUESTS, 50);
+    printf("  %-8s  heap allocs/req %5.1f  arena allocs/req %4.1f  "
+           "p50 %7.0f  p90 %7.0f  p99 %7.0f  p99.9 %7.0f  max %8.0f ns\n",
+           mode_names[mode],
+           (double)(heap_allocs - heap_before) / (WARMUP + REQUESTS),
+           (double)(arena->allocs - arena_before) / (WARMUP + REQUESTS),
+           percentile(lat, REQUESTS, 50), percentile(lat, REQUESTS, 90),
+           percentile(lat, REQUESTS, 99), percentile(lat, REQUESTS, 99.9),
+           lat[REQUESTS - 1]);
+    return h;
+}
+
+// single-transform latency, cached table against per-call twiddles
+static void bench_transform(void) {
+    uint16_t a[KYBER_POL_LENGTH];
+    struct timespec t0, t1;
+    double ns[2];
+
+    rng_state = 0x9e3779b9;
+    random_poly(a);
+    for (int uncached = 0; uncached < 2; uncached++) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int r = 0; r < REQUESTS; r++) {
+            if (uncached)
+                ntt_uncached(a, KYBER_POL_LENGTH, 910);
+            else
+                ntt_standard(a, KYBER_POL_LENGTH, 910);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns[uncached] = elapsed_ns(t0, t1) / REQUESTS;
+    }
+    printf("ntt_standard(256): %.0f ns with per-call twiddles, %.0f ns with the cached table\n", ns[1], ns[0]);
+}
+
+// a thread that uses its arena and exits; the mapping must be gone afterwards
+static void *arena_thread_main(void *arg) {
+    poly_arena *arena = poly_arena_thread();
+    poly_arena *copy = arg;
+    if (arena && poly_alloc(arena)) *copy = *arena;
+    return NULL;
+}
+
+static int arena_released_at_exit(void) {
+    poly_arena seen;
+    pthread_t tid;
+
+    memset(&seen, 0, sizeof(seen));
+    if (pthread_create(&tid, NULL, arena_thread_main, &seen) != 0) return 0;
+    pthread_join(tid, NULL);
+    if (!seen.base) return 0;
+    // msync on unmapped memory fails with ENOMEM
+    return msync(seen.base, seen.size, MS_ASYNC) == -1 && errno == ENOMEM;
+}
+
+int main(int argc, char *argv[]) {
+    static const char *backing[] = {"4 KiB pages", "hugetlbfs", "transparent huge pages"};
+    int flags = (argc > 1 && strcmp(argv[1], "hugepages") == 0) ? POLY_ARENA_HUGEPAGES : 0;
+    double *lat = malloc(REQUESTS * sizeof(double));
+    poly_arena *arena;
+    int errors = 0;
+
+    if (!lat || poly_arena_thread_init(POLY_ARENA_DEFAULT_SIZE, flags) != 0) {
+        fprintf(stderr, "setup failed\n");
+        return 1;
+    }
+    arena = poly_arena_thread();
+    printf("arena: %zu bytes, %s\n", arena->size, backing[arena->backing]);
+
+    // alignment contract used by the SIMD kernels
+    {
+        polyvec v;
+        if (polyvec_alloc(&v, arena, 3) != 0 || ((uintptr_t)v.vec % POLY_ARENA_ALIGN) != 0 ||
+            ((uintptr_t)poly_arena_alloc(arena, 1) % POLY_ARENA_ALIGN) != 0 ||
+            ((uintptr_t)poly_alloc(arena) % POLY_ARENA_ALIGN) != 0) {
+            printf("ERROR: misaligned arena allocation\n");
+            errors++;
+        }
+        poly_arena_reset(arena);
+        if (poly_arena_alloc(arena, arena->size + 1) != NULL || arena->failures != 1) {
+            printf("ERROR: oversized allocation not rejected\n");
+            errors++;
+        }
+        poly_arena_reset(arena);
+    }
+    if (!arena_released_at_exit()) {
+        printf("ERROR: arena of an exited thread still mapped\n");
+        errors++;
+    }
+
+    bench_transform();
+    for (int k = 2; k <= 4; k++) {
+        uint32_t h[3];
+        double p50[3];
+
+        printf("k = %d (%d polynomials per request)\n", k, k * k + 2 * k);
+        for (int mode = MODE_BASELINE; mode <= MODE_ARENA; mode++) h[mode] = run(mode, arena, k, lat, &p50[mode]);
+        printf("  p50 gain: twiddle cache %+.1f%% (baseline -> heap), arena %+.1f%% (heap -> arena)\n",
+               100.0 * (p50[MODE_BASELINE] - p50[MODE_HEAP]) / p50[MODE_BASELINE],
+               100.0 * (p50[MODE_HEAP] - p50[MODE_ARENA]) / p50[MODE_HEAP]);
+        if (h[MODE_BASELINE] != h[MODE_ARENA] || h[MODE_HEAP] != h[MODE_ARENA]) {
+            printf("ERROR: results differ between modes\n");
+            errors++;
+        }
+        if (arena->failures != 1) {
+            printf("ERROR: arena ran out of memory\n");
+            errors++;
+        }
+    }
+    printf("arena high water mark: %zu bytes, %llu resets\n", arena->high_water,
+           (unsigned long long)arena->resets);
+
+    free(lat);
+    poly_arena_destroy(arena);
+
+    if (errors) {
+        printf("\nERROR: %d failures\n", errors);
+        return 1;
+    }
+    printf("\nall arena checks passed\n");
+    return 0;
+}
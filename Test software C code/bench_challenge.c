@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "challenge.h"
+#include "dilithium.h"
+
+// Challenge products of the dilithium signing rejection loop. Every iteration samples a
+// new c and needs c*s1 (l polys), c*s2 and c*t0 (k polys each); s1, s2 and t0 are fixed
+// per key, so their NTT forms are computed once, outside the loop.
+// Routes compared per iteration:
+//   ntt    - c_hat = NTT(c), then pointwise product + inverse NTT per polynomial
+//   ref    - scalar sparse multiplier
+//   sparse - SIMD sparse multiplier (AVX2 builds)
+//   auto   - poly_challenge_mul_auto with the cached NTT forms
+// All routes must agree with each other and with a schoolbook product.
+
+#define RANDOM_TESTS 300
+#define ITERATIONS   2000
+#define MAX_K        8
+#define MAX_L        7
+
+typedef struct {
+    const char *name;
+    int k, l, tau, eta;
+} param_set;
+
+static const param_set params[] = {
+    {"Dilithium2", 4, 4, 39, 2},
+    {"Dilithium3", 6, 5, 49, 4},
+    {"Dilithium5", 8, 7, 60, 2},
+};
+#define PARAM_COUNT ((int)(sizeof(params) / sizeof(params[0])))
+
+enum { ROUTE_NTT, ROUTE_REF, ROUTE_SPARSE, ROUTE_AUTO, ROUTE_COUNT };
+static const char *route_names[ROUTE_COUNT] = {"ntt", "ref", "sparse", "auto"};
+
+// small xorshift generator so runs are reproducible
+static uint32_t rng_state = 0x12345678;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// uniform in [-bound, bound], stored as a residue mod Q
+static void random_small(int32_t *a, int32_t bound) {
+    for (int i = 0; i < DILITHIUM_N; i++)
+        a[i] = dil_reduce((int32_t)(rng() % (2 * bound + 1)) - bound);
+}
+
+static void random_poly(int32_t *a) {
+    for (int i = 0; i < DILITHIUM_N; i++) a[i] = rng() % DILITHIUM_Q;
+}
+
+// tau distinct positions with random signs, as SampleInBall produces them
+static void random_challenge(challenge *c, int tau) {
+    int32_t cpoly[DILITHIUM_N] = {0};
+    for (int t = 0; t < tau; t++) {
+        int p;
+        do p = rng() % DILITHIUM_N; while (cpoly[p] != 0);
+        cpoly[p] = (rng() & 1) ? DILITHIUM_Q - 1 : 1;
+    }
+    challenge_from_poly(c, cpoly);
+}
+
+static void schoolbook(int32_t *r, const int32_t *a, const int32_t *b) {
+    int64_t acc[DILITHIUM_N] = {0};
+    for (int i = 0; i < DILITHIUM_N; i++) {
+        for (int j = 0; j < DILITHIUM_N; j++) {
+            int64_t p = (int64_t)a[i] * b[j];
+            if (i + j < DILITHIUM_N) acc[i + j] += p;
+            else acc[i + j - DILITHIUM_N] -= p;
+        }
+    }
+    for (int i = 0; i < DILITHIUM_N; i++) r[i] = dil_reduce(acc[i] % DILITHIUM_Q);
+}
+
+static void ntt_route(int32_t *r, const int32_t *c_hat, const int32_t *a_hat) {
+    dil_pointwise(r, c_hat, a_hat);
+    dil_intt(r);
+}
+
+static double elapsed_ns(struct timespec t0, struct timespec t1) {
+    return (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+}
+
+static int check(const char *what, const int32_t *got, const int32_t *expected) {
+    for (int i = 0; i < DILITHIUM_N; i++) {
+        if (got[i] != expected[i]) {
+            printf("ERROR: %s coeff %d: got %d expected %d\n", what, i, got[i], expected[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Correctness
+// -----------------------------------------------------------------------------
+static int test_products(void) {
+    int32_t a[DILITHIUM_N], cpoly[DILITHIUM_N], back[DILITHIUM_N];
+    int32_t expected[DILITHIUM_N], r[DILITHIUM_N], a_hat[DILITHIUM_N], c_hat[DILITHIUM_N];
+    challenge c;
+    int errors = 0;
+
+    for (int n = 0; n < RANDOM_TESTS && !errors; n++) {
+        int tau = (n < 3) ? n * CHALLENGE_MAX_WEIGHT / 2 : params[n % PARAM_COUNT].tau;
+        random_challenge(&c, tau);
+        if (n % 2) random_poly(a);
+        else random_small(a, 1 << 12);
+        // extreme coefficients and the wrap boundary
+        if (n == 3) {
+            for (int i = 0; i < DILITHIUM_N; i++) a[i] = DILITHIUM_Q - 1;
+            memset(cpoly, 0, sizeof(cpoly));
+            cpoly[0] = cpoly[DILITHIUM_N - 1] = 1;
+            cpoly[1] = DILITHIUM_Q - 1;
+            challenge_from_poly(&c, cpoly);
+        }
+
+        challenge_to_poly(cpoly, &c);
+        schoolbook(expected, cpoly, a);
+
+        poly_challenge_mul_ref(r, &c, a);
+        errors += check("ref", r, expected);
+        poly_challenge_mul(r, &c, a);
+        errors += check("sparse", r, expected);
+
+        memcpy(c_hat, cpoly, sizeof(c_hat));
+        memcpy(a_hat, a, sizeof(a_hat));
+        dil_ntt(c_hat);
+        dil_ntt(a_hat);
+        ntt_route(r, c_hat, a_hat);
+        errors += check("ntt", r, expected);
+
+        poly_challenge_mul_auto(r, &c, NULL, a, NULL);
+        errors += check("auto", r, expected);
+        poly_challenge_mul_auto(r, &c, c_hat, a, a_hat);
+        errors += check("auto (cached)", r, expected);
+
+        challenge_to_poly(back, &c);
+        if (challenge_from_poly(&c, cpoly) != 0 || memcmp(back, cpoly, sizeof(back)) != 0) {
+            printf("ERROR: challenge dense/sparse round trip\n");
+            errors++;
+        }
+    }
+
+    // not a challenge: coefficient 2, and one term too many
+    memset(cpoly, 0, sizeof(cpoly));
+    cpoly[5] = 2;
+    if (challenge_from_poly(&c, cpoly) == 0) {
+        printf("ERROR: coefficient 2 accepted\n");
+        errors++;
+    }
+    for (int i = 0; i <= CHALLENGE_MAX_WEIGHT; i++) cpoly[i] = 1;
+    if (challenge_from_poly(&c, cpoly) == 0) {
+        printf("ERROR: %d terms accepted\n", CHALLENGE_MAX_WEIGHT + 1);
+        errors++;
+    }
+    return errors;
+}
+
+// -----------------------------------------------------------------------------
+// Component timings next to the costs the route model calibrated
+// -----------------------------------------------------------------------------
+static void time_components(void) {
+    int32_t a[DILITHIUM_N], b[DILITHIUM_N], r[DILITHIUM_N];
+    struct timespec t0, t1;
+    challenge c;
+    double ntt, pw, sparse, ref;
+    const challenge_costs *k = challenge_calibrate();
+
+    random_poly(a);
+    random_poly(b);
+    random_challenge(&c, 60);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < ITERATIONS; i++) dil_ntt(a);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ntt = elapsed_ns(t0, t1) / ITERATIONS;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < ITERATIONS; i++) dil_pointwise(a, a, b);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    pw = elapsed_ns(t0, t1) / ITERATIONS;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < ITERATIONS; i++) poly_challenge_mul(r, &c, a), a[i & 255] ^= r[0] & 1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    sparse = elapsed_ns(t0, t1) / ITERATIONS;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < ITERATIONS; i++) poly_challenge_mul_ref(r, &c, a), a[i & 255] ^= r[0] & 1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ref = elapsed_ns(t0, t1) / ITERATIONS;
+
+    printf("components: ntt %.0f ns, pointwise %.0f ns, sparse tau=60 %.0f ns (%.1f/term), "
+           "ref tau=60 %.0f ns (%.1f/term)\n", ntt, pw, sparse, sparse / 60, ref, ref / 60);
+    printf("calibrated: ntt %.0f ns, pointwise %.0f ns, %.1f ns/term + %.0f ns\n",
+           k->ntt, k->pointwise, k->term, k->reduce);
+    printf("cost model: sparse wins for tau < %.0f with both NTT forms cached, < %.0f with neither\n",
+           (k->pointwise + k->ntt - k->reduce) / k->term, (k->pointwise + 3 * k->ntt - k->reduce) / k->term);
+}
+
+// -----------------------------------------------------------------------------
+// Rejection loop products
+// -----------------------------------------------------------------------------
+static int bench_params(const param_set *p) {
+    static int32_t s1[MAX_L][DILITHIUM_N], s2[MAX_K][DILITHIUM_N], t0[MAX_K][DILITHIUM_N];
+    static int32_t s1_hat[MAX_L][DILITHIUM_N], s2_hat[MAX_K][DILITHIUM_N], t0_hat[MAX_K][DILITHIUM_N];
+    static int32_t out[ROUTE_COUNT][MAX_L + 2 * MAX_K][DILITHIUM_N];
+    const int products = p->l + 2 * p->k;
+    const int32_t *in[MAX_L + 2 * MAX_K], *in_hat[MAX_L + 2 * MAX_K];
+    double ns[ROUTE_COUNT];
+    int errors = 0, auto_ntt = 0;
+    uint32_t seed = rng();
+    // transforming c only pays off if the products then take the NTT route
+    int use_c_hat = challenge_mul_route(p->tau, 1, 1) == CHALLENGE_MUL_NTT;
+
+    for (int i = 0; i < p->l; i++) random_small(s1[i], p->eta);
+    for (int i = 0; i < p->k; i++) random_small(s2[i], p->eta);
+    for (int i = 0; i < p->k; i++) random_small(t0[i], 1 << 12);
+    for (int i = 0; i < p->l; i++) memcpy(s1_hat[i], s1[i], sizeof(s1[i])), dil_ntt(s1_hat[i]);
+    for (int i = 0; i < p->k; i++) memcpy(s2_hat[i], s2[i], sizeof(s2[i])), dil_ntt(s2_hat[i]);
+    for (int i = 0; i < p->k; i++) memcpy(t0_hat[i], t0[i], sizeof(t0[i])), dil_ntt(t0_hat[i]);
+
+    // c*s1, c*s2, c*t0 in the order the signer uses them
+    for (int i = 0; i < p->l; i++) in[i] = s1[i], in_hat[i] = s1_hat[i];
+    for (int i = 0; i < p->k; i++) in[p->l + i] = s2[i], in_hat[p->l + i] = s2_hat[i];
+    for (int i = 0; i < p->k; i++) in[p->l + p->k + i] = t0[i], in_hat[p->l + p->k + i] = t0_hat[i];
+
+    for (int route = 0; route < ROUTE_COUNT; route++) {
+        struct timespec t_start, t_end;
+        uint32_t h = 0;
+
+        rng_state = seed;   // same challenges for every route
+        clock_gettime(CLOCK_MONOTONIC, &t_start);
+        for (int it = 0; it < ITERATIONS; it++) {
+            int32_t c_hat[DILITHIUM_N];
+            challenge c;
+
+            random_challenge(&c, p->tau);
+            // NTT(c) once per iteration, shared by all products
+            if (route == ROUTE_NTT || (route == ROUTE_AUTO && use_c_hat)) {
+                challenge_to_poly(c_hat, &c);
+                dil_ntt(c_hat);
+            }
+            for (int j = 0; j < products; j++) {
+                int32_t *r = out[route][j];
+                switch (route) {
+                case ROUTE_NTT:    ntt_route(r, c_hat, in_hat[j]); break;
+                case ROUTE_REF:    poly_challenge_mul_ref(r, &c, in[j]); break;
+                case ROUTE_SPARSE: poly_challenge_mul(r, &c, in[j]); break;
+                default:
+                    auto_ntt += poly_challenge_mul_auto(r, &c, use_c_hat ? c_hat : NULL, in[j],
+                                                        in_hat[j]) == CHALLENGE_MUL_NTT;
+                }
+                h = h * 31 + (uint32_t)r[it % DILITHIUM_N];   // keep the work observable
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t_end);
+        ns[route] = elapsed_ns(t_start, t_end) / ITERATIONS;
+        if (h == 0x5eed) printf(" ");
+    }
+
+    // last iteration's products must match across routes
+    for (int route = 1; route < ROUTE_COUNT; route++)
+        for (int j = 0; j < products; j++)
+            errors += check(route_names[route], out[route][j], out[ROUTE_NTT][j]);
+
+    printf("%-10s tau=%2d, %2d products/iteration:", p->name, p->tau, products);
+    for (int route = 0; route < ROUTE_COUNT; route++)
+        printf("  %s %6.1f us", route_names[route], ns[route] / 1000);
+    printf("  (auto took the NTT route %d times)\n", auto_ntt);
+    return errors;
+}
+
+int main(void) {
+    int errors = test_products();
+
+    time_components();
+    for (int i = 0; i < PARAM_COUNT; i++) errors += bench_params(&params[i]);
+
+    if (errors) {
+        printf("\nERROR: %d failures\n", errors);
+        return 1;
+    }
+    printf("\nall challenge multiplication checks passed\n");
+    return 0;
+}
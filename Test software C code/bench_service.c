@@ -0,0 +1,384 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "ntt.h"
+#include "ntt_batch.h"
+#include "ntt_service.h"
+#include "kyber_params.h"
+
+// Open-loop load generator for the batching service.
+// CLIENTS threads each issue single-polynomial requests on a fixed schedule
+// (forward and inverse alternating) for the given duration, at several offered rates
+// and batching settings. Latency runs from the scheduled issue time to completion,
+// so a client that falls behind schedule still counts the delay.
+// Every result is checked against ntt_standard / the scalar inverse.
+// Before the load points, test_completion checks a batch mixing a waiter with a
+// request whose callback disposes of it, and that out-of-range coefficients are
+// rejected in-process and over the socket.
+//
+//   in-process: ntt_service_submit, then ntt_request_wait on each request
+//   socket:     one connection per client, pipelined, responses read by a second thread
+//
+// usage: bench_service [socket] [seconds]
+
+#define CLIENTS      4
+#define INPUTS       64             //distinct input polynomials, reused round robin
+#define SOCKET_PATH  "/tmp/ntt_service_bench.sock"
+
+typedef struct {
+    const char *name;
+    int max_batch;
+    int window_us;
+} batch_setting;
+
+static const batch_setting settings[] = {
+    {"off",    1,   0},     //every request dispatched on its own
+    {"greedy", 64,  0},     //whatever queued up while the worker was busy
+    {"20us",   64,  20},
+    {"50us",   64,  50},
+    {"200us",  64,  200},
+};
+#define SETTING_COUNT ((int)(sizeof(settings) / sizeof(settings[0])))
+
+static const int rates[] = {20000, 50000, 100000, 200000, 400000};
+#define RATE_COUNT ((int)(sizeof(rates) / sizeof(rates[0])))
+
+static uint16_t inputs[INPUTS][KYBER_POL_LENGTH];
+static uint16_t expected[2][INPUTS][KYBER_POL_LENGTH];
+
+typedef struct {
+    int client;
+    int count;                  //requests issued by this client
+    uint64_t interval_ns;
+    uint64_t start_ns;
+    int use_socket;
+    ntt_service *service;
+
+    uint16_t (*coeffs)[KYBER_POL_LENGTH];
+    ntt_request *reqs;          //in-process only
+    uint64_t *sched_ns;
+    uint64_t *latency_ns;
+    int errors;
+    int fd;                     //socket only
+} client_state;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_until(uint64_t t) {
+    struct timespec ts;
+    if (now_ns() >= t) return;
+    ts.tv_sec = (time_t)(t / 1000000000ull);
+    ts.tv_nsec = (long)(t % 1000000000ull);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+// request i of client c: input (c * count + i) % INPUTS, mode i & 1
+static int input_of(const client_state *cs, int i) {
+    return (cs->client * cs->count + i) % INPUTS;
+}
+
+static void check(client_state *cs, int i, int32_t status, const uint16_t *out) {
+    if (status != NTT_SERVICE_OK || memcmp(out, expected[i & 1][input_of(cs, i)], sizeof(inputs[0])) != 0)
+        cs->errors++;
+}
+
+// -----------------------------------------------------------------------------
+// In-process client
+// -----------------------------------------------------------------------------
+static void *inproc_client(void *arg) {
+    client_state *cs = arg;
+
+    for (int i = 0; i < cs->count; i++) {
+        cs->sched_ns[i] = cs->start_ns + i * cs->interval_ns;
+        sleep_until(cs->sched_ns[i]);
+        memcpy(cs->coeffs[i], inputs[input_of(cs, i)], sizeof(inputs[0]));
+        memset(&cs->reqs[i], 0, sizeof(cs->reqs[i]));
+        cs->reqs[i].coeffs = cs->coeffs[i];
+        cs->reqs[i].mode = i & 1;
+        ntt_service_submit(cs->service, &cs->reqs[i]);
+    }
+    for (int i = 0; i < cs->count; i++) {
+        int status = ntt_request_wait(cs->service, &cs->reqs[i]);
+        cs->latency_ns[i] = cs->reqs[i].complete_ns - cs->sched_ns[i];
+        check(cs, i, status, cs->coeffs[i]);
+    }
+    return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Socket client: the sender keeps the schedule, a receiver thread collects responses
+// -----------------------------------------------------------------------------
+static void *socket_receiver(void *arg) {
+    client_state *cs = arg;
+    uint16_t out[KYBER_POL_LENGTH];
+    uint32_t id;
+    int32_t status;
+
+    for (int n = 0; n < cs->count; n++) {
+        if (ntt_client_recv(cs->fd, &id, &status, out) != 0 || id >= (uint32_t)cs->count) {
+            cs->errors += cs->count - n;
+            break;
+        }
+        cs->latency_ns[id] = now_ns() - cs->sched_ns[id];
+        check(cs, (int)id, status, out);
+    }
+    return NULL;
+}
+
+static void *socket_client(void *arg) {
+    client_state *cs = arg;
+    pthread_t receiver;
+
+    pthread_create(&receiver, NULL, socket_receiver, cs);
+    for (int i = 0; i < cs->count; i++) {
+        cs->sched_ns[i] = cs->start_ns + i * cs->interval_ns;
+        sleep_until(cs->sched_ns[i]);
+        if (ntt_client_send(cs->fd, (uint32_t)i, i & 1, inputs[input_of(cs, i)]) != 0) break;
+    }
+    pthread_join(receiver, NULL);
+    return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Completion checks
+// -----------------------------------------------------------------------------
+// a callback may free or reuse its request at once. this one wipes it, so a service
+// that still touches the request after the callback leaves completed set.
+static void wipe_done(ntt_request *req, void *arg) {
+    memcpy(arg, req->coeffs, sizeof(inputs[0]));
+    memset(req, 0, sizeof(*req));
+}
+
+static int test_completion(void) {
+    ntt_service_config cfg = {2, 100000, 1};    //both requests in one batch, flushed by size
+    ntt_service s;
+    uint16_t a[KYBER_POL_LENGTH];
+    int errors = 0, fd;
+
+    if (ntt_service_init(&s, &cfg) != 0 || ntt_service_start(&s) != 0) {
+        printf("ERROR: service did not start\n");
+        return 1;
+    }
+
+    for (int n = 0; n < 8; n++) {
+        uint16_t w_coeffs[KYBER_POL_LENGTH], cb_coeffs[KYBER_POL_LENGTH], cb_out[KYBER_POL_LENGTH];
+        ntt_request waiter = {0}, cb = {0};
+        int mode = n & 1;
+
+        memcpy(w_coeffs, inputs[n], sizeof(w_coeffs));
+        memcpy(cb_coeffs, inputs[n + 1], sizeof(cb_coeffs));
+        waiter.coeffs = w_coeffs;
+        waiter.mode = mode;
+        cb.coeffs = cb_coeffs;
+        cb.mode = mode;
+        cb.done = wipe_done;
+        cb.done_arg = cb_out;
+        // either order within the batch
+        if (n & 2) {
+            ntt_service_submit(&s, &cb);
+            ntt_service_submit(&s, &waiter);
+        } else {
+            ntt_service_submit(&s, &waiter);
+            ntt_service_submit(&s, &cb);
+        }
+        if (ntt_request_wait(&s, &waiter) != NTT_SERVICE_OK ||
+            memcmp(w_coeffs, expected[mode][n], sizeof(w_coeffs)) != 0 ||
+            memcmp(cb_out, expected[mode][n + 1], sizeof(cb_out)) != 0) {
+            printf("ERROR: mixed waiter/callback batch %d gave wrong results\n", n);
+            errors++;
+        }
+        if (cb.completed || cb.done) {
+            printf("ERROR: service wrote to a callback request after its callback\n");
+            errors++;
+        }
+    }
+
+    memcpy(a, inputs[0], sizeof(a));
+    a[17] = Q;
+    if (ntt_service_call(&s, a, NTT_BATCH_FORWARD) != NTT_SERVICE_EINVAL) {
+        printf("ERROR: coefficient Q accepted in-process\n");
+        errors++;
+    }
+
+    fd = (ntt_service_listen(&s, SOCKET_PATH) == 0) ? ntt_client_connect(SOCKET_PATH) : -1;
+    if (fd < 0) {
+        printf("ERROR: socket front end unavailable\n");
+        errors++;
+    } else {
+        memcpy(a, inputs[0], sizeof(a));
+        a[KYBER_POL_LENGTH - 1] = 0xffff;
+        if (ntt_client_call(fd, a, NTT_BATCH_FORWARD) != NTT_SERVICE_EINVAL) {
+            printf("ERROR: coefficient >= Q accepted over the socket\n");
+            errors++;
+        }
+        memcpy(a, inputs[0], sizeof(a));
+        if (ntt_client_call(fd, a, NTT_BATCH_FORWARD) != NTT_SERVICE_OK ||
+            memcmp(a, expected[NTT_BATCH_FORWARD][0], sizeof(a)) != 0) {
+            printf("ERROR: socket request after a rejected one\n");
+            errors++;
+        }
+        close(fd);
+    }
+
+    ntt_service_destroy(&s);
+    return errors;
+}
+
+// -----------------------------------------------------------------------------
+// Driver
+// -----------------------------------------------------------------------------
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_us(const uint64_t *sorted, int n, double p) {
+    int i = (int)(p * (n - 1) + 0.5);
+    return sorted[i] / 1000.0;
+}
+
+static int run(const batch_setting *bs, int rate, double seconds, int use_socket) {
+    ntt_service svc;
+    ntt_service_config cfg = {bs->max_batch, bs->window_us, 1};
+    ntt_service_stats st;
+    client_state cs[CLIENTS];
+    pthread_t threads[CLIENTS];
+    int per_client = (int)(rate * seconds / CLIENTS);
+    int total = per_client * CLIENTS;
+    int errors = 0;
+
+    if (ntt_service_init(&svc, &cfg) != 0 || ntt_service_start(&svc) != 0) {
+        printf("service start failed\n");
+        return -1;
+    }
+    if (use_socket && ntt_service_listen(&svc, SOCKET_PATH) != 0) {
+        printf("listen on %s failed\n", SOCKET_PATH);
+        ntt_service_destroy(&svc);
+        return -1;
+    }
+
+    uint64_t *latency = malloc((size_t)total * sizeof(uint64_t));
+    uint64_t start = now_ns() + 2000000;   //let every client get going first
+    for (int c = 0; c < CLIENTS; c++) {
+        cs[c].client = c;
+        cs[c].count = per_client;
+        cs[c].interval_ns = (uint64_t)(1e9 * CLIENTS / rate);
+        cs[c].start_ns = start + c * cs[c].interval_ns / CLIENTS;  //interleave the clients
+        cs[c].use_socket = use_socket;
+        cs[c].service = &svc;
+        cs[c].coeffs = use_socket ? NULL : malloc((size_t)per_client * sizeof(*cs[c].coeffs));
+        cs[c].reqs = use_socket ? NULL : malloc((size_t)per_client * sizeof(ntt_request));
+        cs[c].sched_ns = malloc((size_t)per_client * sizeof(uint64_t));
+        cs[c].latency_ns = latency + c * per_client;
+        cs[c].errors = 0;
+        cs[c].fd = use_socket ? ntt_client_connect(SOCKET_PATH) : -1;
+        if (use_socket && cs[c].fd < 0) {
+            printf("connect to %s failed\n", SOCKET_PATH);
+            exit(1);
+        }
+    }
+
+    for (int c = 0; c < CLIENTS; c++)
+        pthread_create(&threads[c], NULL, use_socket ? socket_client : inproc_client, &cs[c]);
+    for (int c = 0; c < CLIENTS; c++) pthread_join(threads[c], NULL);
+    uint64_t end = now_ns();
+
+    ntt_service_get_stats(&svc, &st);
+    ntt_service_destroy(&svc);
+
+    for (int c = 0; c < CLIENTS; c++) {
+        errors += cs[c].errors;
+        if (use_socket) close(cs[c].fd);
+        free(cs[c].coeffs);
+        free(cs[c].reqs);
+        free(cs[c].sched_ns);
+    }
+
+    qsort(latency, total, sizeof(uint64_t), cmp_u64);
+    double elapsed = (end - start) / 1e9;
+    char backends[64] = "";
+    for (int b = 0; b < svc.backend_count; b++) {
+        char item[32];
+        snprintf(item, sizeof(item), "%s%s:%llu", b ? " " : "", svc.backends[b].name,
+                 (unsigned long long)st.backend_polys[b]);
+        strncat(backends, item, sizeof(backends) - strlen(backends) - 1);
+    }
+    printf("%-7s %8d %9.0f %6.1f %8.1f %8.1f %8.1f %9.1f  %s%s\n",
+           bs->name, rate, total / elapsed,
+           st.batches ? (double)st.requests / st.batches : 0.0,
+           percentile_us(latency, total, 0.50), percentile_us(latency, total, 0.90),
+           percentile_us(latency, total, 0.99), percentile_us(latency, total, 0.999),
+           backends, errors ? "  MISMATCH" : "");
+    free(latency);
+    return errors;
+}
+
+int main(int argc, char **argv) {
+    int use_socket = 0;
+    double seconds = 0.1;
+    int errors = 0;
+    uint32_t seed = 0x2468ace1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "socket") == 0)
+            use_socket = 1;
+        else
+            seconds = atof(argv[i]);
+    }
+    if (seconds <= 0) seconds = 0.1;
+
+    for (int p = 0; p < INPUTS; p++) {
+        for (int i = 0; i < KYBER_POL_LENGTH; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            inputs[p][i] = seed % Q;
+        }
+        uint16_t *fwd = expected[NTT_BATCH_FORWARD][p];
+        uint16_t *inv = expected[NTT_BATCH_INVERSE][p];
+        memcpy(fwd, inputs[p], sizeof(inputs[p]));
+        ntt_standard(fwd, KYBER_POL_LENGTH, 910);
+        memcpy(inv, inputs[p], sizeof(inputs[p]));
+        ntt_batch_ref(&inv, 1, NTT_BATCH_INVERSE);
+    }
+
+    // the scalar inverse must undo ntt_standard before it can serve as the reference
+    for (int p = 0; p < INPUTS; p++) {
+        uint16_t a[KYBER_POL_LENGTH];
+        uint16_t *pa = a;
+        memcpy(a, expected[NTT_BATCH_FORWARD][p], sizeof(a));
+        ntt_batch_ref(&pa, 1, NTT_BATCH_INVERSE);
+        if (memcmp(a, inputs[p], sizeof(a)) != 0) {
+            printf("scalar inverse does not undo ntt_standard\n");
+            return 1;
+        }
+    }
+
+    errors += test_completion();
+    printf("completion checks: %s\n\n", errors ? "FAILED" : "mixed batches and range checks OK");
+
+    printf("%s, %d clients, %.2f s per point, latency from scheduled issue time\n",
+           use_socket ? "unix socket" : "in-process", CLIENTS, seconds);
+    printf("%-7s %8s %9s %6s %8s %8s %8s %9s  %s\n",
+           "window", "offered", "achieved", "batch", "p50 us", "p90 us", "p99 us", "p99.9 us", "polys per backend");
+    for (int s = 0; s < SETTING_COUNT; s++) {
+        for (int r = 0; r < RATE_COUNT; r++) {
+            int e = run(&settings[s], rates[r], seconds, use_socket);
+            if (e < 0) return 1;
+            errors += e;
+        }
+        printf("\n");
+    }
+
+    printf("%s\n", errors ? "ERRORS" : "all results match");
+    return errors ? 1 : 0;
+}
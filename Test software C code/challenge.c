@@ -0,0 +1,222 @@
+#include "challenge.h"
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// Dense <-> sparse
+// -----------------------------------------------------------------------------
+int challenge_from_poly(challenge *c, const int32_t *cpoly) {
+    c->weight = 0;
+    c->neg = 0;
+    for (int i = 0; i < DILITHIUM_N; i++) {
+        if (cpoly[i] == 0) continue;
+        if ((cpoly[i] != 1 && cpoly[i] != DILITHIUM_Q - 1) || c->weight == CHALLENGE_MAX_WEIGHT)
+            return -1;
+        if (cpoly[i] != 1) c->neg |= 1ull << c->weight;
+        c->pos[c->weight++] = (uint8_t)i;
+    }
+    return 0;
+}
+
+void challenge_to_poly(int32_t *cpoly, const challenge *c) {
+    memset(cpoly, 0, DILITHIUM_N * sizeof(int32_t));
+    for (int t = 0; t < c->weight; t++)
+        cpoly[c->pos[t]] = ((c->neg >> t) & 1) ? DILITHIUM_Q - 1 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// Scalar reference: x^p * a shifts a up by p, the p coefficients pushed past
+// x^255 wrap around to the bottom with their sign flipped (x^256 = -1)
+// -----------------------------------------------------------------------------
+void poly_challenge_mul_ref(int32_t *r, const challenge *c, const int32_t *a) {
+    int32_t acc[DILITHIUM_N] = {0};
+
+    for (int t = 0; t < c->weight; t++) {
+        int p = c->pos[t];
+        int32_t s = ((c->neg >> t) & 1) ? -1 : 1;
+        for (int j = 0; j < DILITHIUM_N - p; j++)
+            acc[j + p] += s * a[j];
+        for (int j = DILITHIUM_N - p; j < DILITHIUM_N; j++)
+            acc[j + p - DILITHIUM_N] -= s * a[j];
+    }
+    for (int j = 0; j < DILITHIUM_N; j++)
+        r[j] = dil_reduce(acc[j]);
+}
+
+#if defined(__AVX2__)
+// -----------------------------------------------------------------------------
+// AVX2 kernel
+// With ext = (-a, a), coefficient i of x^p * a is ext[256 - p + i], so every term
+// is one contiguous 256-wide window of ext and needs no wrap handling. The result
+// is accumulated in 64-coefficient blocks (8 registers) over all terms, then
+// reduced once: |acc| < 64 * Q < 2^29.
+// -----------------------------------------------------------------------------
+#define CHALLENGE_BLOCK 64
+
+// (-2^31 + 2^22, 2^31 - 2^22) -> [0, Q), same steps as reduce32 + caddq in the reference code
+static inline __m256i reduce_avx2(__m256i x) {
+    const __m256i q = _mm256_set1_epi32(DILITHIUM_Q);
+    __m256i t = _mm256_srai_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1 << 22)), 23);
+    x = _mm256_sub_epi32(x, _mm256_mullo_epi32(t, q));
+    return _mm256_add_epi32(x, _mm256_and_si256(_mm256_srai_epi32(x, 31), q));
+}
+
+static void poly_challenge_mul_avx2(int32_t *r, const challenge *c, const int32_t *a) {
+    int32_t ext[2 * DILITHIUM_N] __attribute__((aligned(32)));
+    __m256i sign[CHALLENGE_MAX_WEIGHT];
+
+    for (int j = 0; j < DILITHIUM_N; j += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + j));
+        _mm256_store_si256((__m256i *)(ext + j), _mm256_sub_epi32(_mm256_setzero_si256(), x));
+        _mm256_store_si256((__m256i *)(ext + DILITHIUM_N + j), x);
+    }
+    for (int t = 0; t < c->weight; t++)
+        sign[t] = _mm256_set1_epi32(((c->neg >> t) & 1) ? -1 : 1);
+
+    for (int b = 0; b < DILITHIUM_N; b += CHALLENGE_BLOCK) {
+        __m256i acc[CHALLENGE_BLOCK / 8];
+        for (int i = 0; i < CHALLENGE_BLOCK / 8; i++) acc[i] = _mm256_setzero_si256();
+
+        for (int t = 0; t < c->weight; t++) {
+            const int32_t *w = ext + DILITHIUM_N - c->pos[t] + b;
+            for (int i = 0; i < CHALLENGE_BLOCK / 8; i++) {
+                __m256i x = _mm256_loadu_si256((const __m256i *)(w + 8 * i));
+                acc[i] = _mm256_add_epi32(acc[i], _mm256_sign_epi32(x, sign[t]));
+            }
+        }
+
+        for (int i = 0; i < CHALLENGE_BLOCK / 8; i++)
+            _mm256_storeu_si256((__m256i *)(r + b + 8 * i), reduce_avx2(acc[i]));
+    }
+}
+#endif
+
+void poly_challenge_mul(int32_t *r, const challenge *c, const int32_t *a) {
+#if defined(__AVX2__)
+    poly_challenge_mul_avx2(r, c, a);
+#else
+    poly_challenge_mul_ref(r, c, a);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Cost calibration
+// Every cost is the fastest of a few short batches, which filters out preemption.
+// The per-term cost is the slope between a light and a full challenge, the rest of
+// the sparse multiplier is the intercept.
+// -----------------------------------------------------------------------------
+#define CAL_BATCHES 8
+#define CAL_CALLS   8
+#define CAL_LO      8
+#define CAL_HI      CHALLENGE_MAX_WEIGHT
+
+enum { CAL_NTT, CAL_POINTWISE, CAL_SPARSE_LO, CAL_SPARSE_HI };
+
+static challenge_costs costs = {
+#if defined(__AVX2__)
+    CHALLENGE_COST_TERM,
+#else
+    CHALLENGE_COST_TERM_REF,
+#endif
+    CHALLENGE_COST_REDUCE, CHALLENGE_COST_NTT, CHALLENGE_COST_POINTWISE
+};
+static pthread_once_t costs_once = PTHREAD_ONCE_INIT;
+
+static double now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static double fastest_ns(int what, int32_t *r, const int32_t *a, const challenge *lo, const challenge *hi) {
+    double best = 0;
+
+    for (int b = 0; b < CAL_BATCHES; b++) {
+        double t0 = now_ns(), t;
+        for (int i = 0; i < CAL_CALLS; i++) {
+            switch (what) {
+            case CAL_NTT:       dil_ntt(r); break;
+            case CAL_POINTWISE: dil_pointwise(r, r, a); break;
+            case CAL_SPARSE_LO: poly_challenge_mul(r, lo, a); break;
+            default:            poly_challenge_mul(r, hi, a); break;
+            }
+        }
+        t = (now_ns() - t0) / CAL_CALLS;
+        if (b == 0 || t < best) best = t;
+    }
+    return best;
+}
+
+static void calibrate(void) {
+    int32_t a[DILITHIUM_N], r[DILITHIUM_N];
+    challenge lo, hi;
+    double ntt, pointwise, t_lo, t_hi;
+
+    for (int i = 0; i < DILITHIUM_N; i++) a[i] = r[i] = (int32_t)((i * 2654435761u) % DILITHIUM_Q);
+    lo.weight = CAL_LO;
+    hi.weight = CAL_HI;
+    lo.neg = hi.neg = 0x5555555555555555ull;
+    for (int t = 0; t < CAL_HI; t++) {
+        hi.pos[t] = (uint8_t)(t * (DILITHIUM_N / CAL_HI) + 1);
+        if (t < CAL_LO) lo.pos[t] = (uint8_t)(t * (DILITHIUM_N / CAL_LO) + 1);
+    }
+
+    ntt = fastest_ns(CAL_NTT, r, a, &lo, &hi);
+    pointwise = fastest_ns(CAL_POINTWISE, r, a, &lo, &hi);
+    t_lo = fastest_ns(CAL_SPARSE_LO, r, a, &lo, &hi);
+    t_hi = fastest_ns(CAL_SPARSE_HI, r, a, &lo, &hi);
+    if (ntt <= 0 || pointwise <= 0 || t_hi <= t_lo) return;   // clock unusable: keep the defaults
+
+    costs.term = (t_hi - t_lo) / (CAL_HI - CAL_LO);
+    costs.reduce = (t_lo > CAL_LO * costs.term) ? t_lo - CAL_LO * costs.term : 0;
+    costs.ntt = ntt;
+    costs.pointwise = pointwise;
+}
+
+const challenge_costs *challenge_calibrate(void) {
+    pthread_once(&costs_once, calibrate);
+    return &costs;
+}
+
+// -----------------------------------------------------------------------------
+// Route selection
+// -----------------------------------------------------------------------------
+int challenge_mul_route(int weight, int a_in_ntt, int c_in_ntt) {
+    const challenge_costs *k = challenge_calibrate();
+    double sparse = weight * k->term + k->reduce;
+    double ntt = k->pointwise + k->ntt;
+
+    if (!a_in_ntt) ntt += k->ntt;
+    if (!c_in_ntt) ntt += k->ntt;
+    return (ntt < sparse) ? CHALLENGE_MUL_NTT : CHALLENGE_MUL_SPARSE;
+}
+
+int poly_challenge_mul_auto(int32_t *r, const challenge *c, const int32_t *c_hat,
+                            const int32_t *a, const int32_t *a_hat) {
+    int32_t tmp[DILITHIUM_N];
+
+    if (challenge_mul_route(c->weight, a_hat != NULL, c_hat != NULL) == CHALLENGE_MUL_SPARSE) {
+        poly_challenge_mul(r, c, a);
+        return CHALLENGE_MUL_SPARSE;
+    }
+
+    if (!c_hat) {
+        challenge_to_poly(tmp, c);
+        dil_ntt(tmp);
+        c_hat = tmp;
+    }
+    if (a_hat) {
+        dil_pointwise(r, c_hat, a_hat);
+    } else {
+        memcpy(r, a, DILITHIUM_N * sizeof(int32_t));
+        dil_ntt(r);
+        dil_pointwise(r, r, c_hat);
+    }
+    dil_intt(r);
+    return CHALLENGE_MUL_NTT;
+}
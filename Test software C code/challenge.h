@@ -0,0 +1,68 @@
+#ifndef CHALLENGE_H
+#define CHALLENGE_H
+
+#include <stdint.h>
+#include "dilithium.h"
+
+// Dilithium challenge c: tau coefficients of +-1, all others 0 (tau = 39, 49, 60).
+// The sparse multiplier works on the position/sign list instead of the dense poly.
+// With at most 64 terms of magnitude < Q the accumulator stays below 2^29.
+#define CHALLENGE_MAX_WEIGHT 64
+
+typedef struct {
+    int weight;                         // tau, number of nonzero coefficients
+    uint8_t pos[CHALLENGE_MAX_WEIGHT];  // exponent of each term
+    uint64_t neg;                       // bit i set: term i is -x^pos[i]
+} challenge;
+
+// dense <-> sparse. challenge_from_poly returns -1 if c has a coefficient other than
+// 0, 1, Q - 1 or more than CHALLENGE_MAX_WEIGHT nonzero coefficients.
+int challenge_from_poly(challenge *c, const int32_t *cpoly);
+void challenge_to_poly(int32_t *cpoly, const challenge *c);
+
+// r = c * a mod (x^256 + 1), a and r in [0, Q). r must not alias a.
+// the SIMD kernel is used when the build enables AVX2, the scalar code otherwise.
+void poly_challenge_mul(int32_t *r, const challenge *c, const int32_t *a);
+
+// scalar reference: one shifted negacyclic add/sub per term
+void poly_challenge_mul_ref(int32_t *r, const challenge *c, const int32_t *a);
+
+// -----------------------------------------------------------------------------
+// Route selection
+// The NTT route costs a pointwise product and an inverse transform, plus a forward
+// transform for each operand not already in the NTT domain. In the signing loop
+// s1, s2 and t0 are transformed once per signature and c once per iteration, so
+// whether a product is cheaper sparse or through the NTT depends on what is cached.
+// -----------------------------------------------------------------------------
+enum { CHALLENGE_MUL_SPARSE, CHALLENGE_MUL_NTT };
+
+// Per-call costs in nanoseconds. Absolute timings move with the machine and its load
+// but the crossover only depends on their ratios, so the costs are measured back to
+// back on the running machine, once per process (challenge_calibrate, also run by
+// the first challenge_mul_route). The defaults are one bench_challenge run on
+// x86-64 -O2 and only stand in when the clock is unusable.
+typedef struct {
+    double term;        // sparse: one shifted add of 256 coefficients
+    double reduce;      // sparse: fixed part, setup and final reduction to [0, Q)
+    double ntt;         // dil_ntt or dil_intt
+    double pointwise;   // dil_pointwise
+} challenge_costs;
+
+#define CHALLENGE_COST_TERM      26     // AVX2 kernel
+#define CHALLENGE_COST_TERM_REF  140    // scalar reference
+#define CHALLENGE_COST_REDUCE    80
+#define CHALLENGE_COST_NTT       2000
+#define CHALLENGE_COST_POINTWISE 280
+
+// thread-safe, measures on the first call (about a millisecond) and then returns
+// the cached costs
+const challenge_costs *challenge_calibrate(void);
+
+int challenge_mul_route(int weight, int a_in_ntt, int c_in_ntt);
+
+// r = c * a by the route challenge_mul_route picks. c_hat and a_hat are the NTT forms
+// of c and a if the caller has them, NULL otherwise; r must not alias a or a_hat.
+int poly_challenge_mul_auto(int32_t *r, const challenge *c, const int32_t *c_hat,
+                            const int32_t *a, const int32_t *a_hat);
+
+#endif
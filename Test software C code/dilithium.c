@@ -0,0 +1,84 @@
+#include "dilithium.h"
+#include "ntt.h"
+#include <pthread.h>
+
+int32_t dil_reduce(int64_t a) {
+    int32_t r = (int32_t)(a % DILITHIUM_Q);
+    return (r < 0) ? r + DILITHIUM_Q : r;
+}
+
+int32_t dil_add(int32_t a, int32_t b) {
+    int32_t r = a + b;
+    return (r >= DILITHIUM_Q) ? r - DILITHIUM_Q : r;
+}
+
+int32_t dil_sub(int32_t a, int32_t b) {
+    return (a >= b) ? (a - b) : (DILITHIUM_Q + a - b);
+}
+
+int32_t dil_mul(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b) % DILITHIUM_Q);
+}
+
+static int32_t dil_pow(int32_t base, uint32_t exp) {
+    int32_t res = 1;
+    while (exp) {
+        if (exp & 1) res = dil_mul(res, base);
+        base = dil_mul(base, base);
+        exp >>= 1;
+    }
+    return res;
+}
+
+// zetas[k] = ROOT^bitrev8(k), same ordering as the dilithium reference code
+// built once per process, callers may be on several threads (pthread_once)
+static int32_t zetas[DILITHIUM_N];
+static int32_t n_inv;
+static pthread_once_t zetas_once = PTHREAD_ONCE_INIT;
+
+static void init_zetas(void) {
+    for (int k = 0; k < DILITHIUM_N; k++)
+        zetas[k] = dil_pow(DILITHIUM_ROOT, bit_reverse(k, 8));
+    n_inv = dil_pow(DILITHIUM_N, DILITHIUM_Q - 2);
+}
+
+// Cooley-Tukey, natural order in, bit-reversed order out
+void dil_ntt(int32_t *a) {
+    int k = 0;
+
+    pthread_once(&zetas_once, init_zetas);
+    for (int len = DILITHIUM_N / 2; len > 0; len >>= 1) {
+        for (int start = 0; start < DILITHIUM_N; start += 2 * len) {
+            int32_t zeta = zetas[++k];
+            for (int j = start; j < start + len; j++) {
+                int32_t t = dil_mul(zeta, a[j + len]);
+                a[j + len] = dil_sub(a[j], t);
+                a[j] = dil_add(a[j], t);
+            }
+        }
+    }
+}
+
+// Gentleman-Sande, bit-reversed order in, natural order out, scaled by 1/256
+void dil_intt(int32_t *a) {
+    int k = DILITHIUM_N;
+
+    pthread_once(&zetas_once, init_zetas);
+    for (int len = 1; len < DILITHIUM_N; len <<= 1) {
+        for (int start = 0; start < DILITHIUM_N; start += 2 * len) {
+            int32_t zeta = DILITHIUM_Q - zetas[--k];
+            for (int j = start; j < start + len; j++) {
+                int32_t t = a[j];
+                a[j] = dil_add(t, a[j + len]);
+                a[j + len] = dil_mul(zeta, dil_sub(t, a[j + len]));
+            }
+        }
+    }
+    for (int j = 0; j < DILITHIUM_N; j++)
+        a[j] = dil_mul(a[j], n_inv);
+}
+
+void dil_pointwise(int32_t *r, const int32_t *a, const int32_t *b) {
+    for (int j = 0; j < DILITHIUM_N; j++)
+        r[j] = dil_mul(a[j], b[j]);
+}
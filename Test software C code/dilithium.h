@@ -0,0 +1,22 @@
+#ifndef DILITHIUM_H
+#define DILITHIUM_H
+
+#include <stdint.h>
+
+#define DILITHIUM_Q 8380417 //prime modulus used in dilithium, 2^23 - 2^13 + 1
+#define DILITHIUM_N 256 //length of polynomial coefficient arrays
+#define DILITHIUM_ROOT 1753 //primitive 512th root of unity mod DILITHIUM_Q
+
+// coefficients are kept in [0, DILITHIUM_Q), small signed values as their residue
+int32_t dil_reduce(int64_t a);
+int32_t dil_add(int32_t a, int32_t b);
+int32_t dil_sub(int32_t a, int32_t b);
+int32_t dil_mul(int32_t a, int32_t b);
+
+// negacyclic NTT over Z_q[x]/(x^256 + 1), bit-reversed output order.
+// ntt(a) o ntt(b) followed by intt gives a * b mod (x^256 + 1), the 1/256 is included.
+void dil_ntt(int32_t *a);
+void dil_intt(int32_t *a);
+void dil_pointwise(int32_t *r, const int32_t *a, const int32_t *b);
+
+#endif
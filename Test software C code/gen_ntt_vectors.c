@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ntt.h"
+#include "poly_ntt.h"
+#include "kyber_params.h"
+#include "dilithium.h"
+
+// Reference vectors for the parameterized hardware datapath (tb_NTT_datapath_params).
+// The transform is the one the NTT_AXI_wrapper runs: ntt_standard/intt_standard with a
+// root omega of order 128, for any modulus. It is checked against ntt_standard and the
+// scalar inverse for Kyber, and by round trip for every modulus, then written out as
+// $readmemh files: <name>_in.mem (inputs) and <name>_ntt.mem (forward transforms),
+// VECTOR_POLYS polynomials of 256 coefficients each, one hex value per line.
+//
+// usage: gen_ntt_vectors [output directory]
+
+#define VECTOR_POLYS 4
+#define N            256
+
+typedef struct {
+    const char *name;
+    uint64_t q;
+    uint64_t omega;
+} ntt_params;
+
+// OMEGA of twiddle_ROM / NTT_AXI_wrapper: Kyber 910, Dilithium 1753^4 (both of order 128)
+static const ntt_params schemes[] = {
+    {"kyber",     Q,           910},
+    {"dilithium", DILITHIUM_Q, 3602218},
+};
+#define SCHEME_COUNT ((int)(sizeof(schemes) / sizeof(schemes[0])))
+
+static uint64_t pow_mod(uint64_t b, uint64_t e, uint64_t q) {
+    uint64_t r = 1;
+    b %= q;
+    while (e) {
+        if (e & 1) r = r * b % q;
+        b = b * b % q;
+        e >>= 1;
+    }
+    return r;
+}
+
+static int bitrev7(int i) {
+    int r = 0;
+    for (int k = 0; k < 7; k++) r = (r << 1) | ((i >> k) & 1);
+    return r;
+}
+
+// x / 2 mod q, as the butterfly does it: (q - 1) / 2 + (x + 1) / 2 for odd x
+static uint64_t div2(uint64_t x, uint64_t q) {
+    return (x & 1) ? (q - 1) / 2 + (x + 1) / 2 : x / 2;
+}
+
+// same loop structure as ntt_standard, twiddle_ROM entries 0..127
+static void ntt_generic(uint64_t *a, const ntt_params *p) {
+    for (int len = N / 2; len >= 1; len >>= 1) {
+        int step = N / (2 * len);
+        for (int start = 0; start < N; start += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                uint64_t w = pow_mod(p->omega, bitrev7(j * step), p->q);
+                uint64_t u = a[start + j];
+                uint64_t v = a[start + j + len] * w % p->q;
+                a[start + j] = (u + v) % p->q;
+                a[start + j + len] = (u + p->q - v) % p->q;
+            }
+        }
+    }
+}
+
+// same loop structure as intt_standard, twiddle_ROM entries 128..255
+static void intt_generic(uint64_t *a, const ntt_params *p) {
+    uint64_t omega_inv = pow_mod(p->omega, p->q - 2, p->q);
+    for (int len = 1; len < N; len <<= 1) {
+        int step = N / (2 * len);
+        for (int start = 0; start < N; start += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                uint64_t w = pow_mod(omega_inv, bitrev7(j * step), p->q);
+                uint64_t u = a[start + j];
+                uint64_t v = a[start + j + len];
+                a[start + j] = div2((u + v) % p->q, p->q);
+                a[start + j + len] = div2((u + p->q - v) % p->q * w % p->q, p->q);
+            }
+        }
+    }
+}
+
+static uint32_t rng_state = 0x1b873593;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// poly 0: ramp, 1: all q - 1, others random
+static void make_input(uint64_t *a, int poly, uint64_t q) {
+    for (int i = 0; i < N; i++) {
+        if (poly == 0)
+            a[i] = (uint64_t)(2 * i) % q;
+        else if (poly == 1)
+            a[i] = q - 1;
+        else
+            a[i] = (((uint64_t)rng() << 32) | rng()) % q;
+    }
+}
+
+static int write_mem(const char *dir, const char *name, const char *suffix,
+                     uint64_t (*polys)[N], int digits) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s_%s.mem", dir, name, suffix);
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        printf("cannot write %s\n", path);
+        return -1;
+    }
+    for (int p = 0; p < VECTOR_POLYS; p++)
+        for (int i = 0; i < N; i++)
+            fprintf(f, "%0*llx\n", digits, (unsigned long long)polys[p][i]);
+    fclose(f);
+    printf("wrote %s\n", path);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *dir = argc > 1 ? argv[1] : ".";
+    static uint64_t in[VECTOR_POLYS][N], out[VECTOR_POLYS][N];
+    int errors = 0;
+
+    for (int s = 0; s < SCHEME_COUNT; s++) {
+        const ntt_params *p = &schemes[s];
+        int digits = 0;
+        for (uint64_t v = p->q - 1; v; v >>= 4) digits++;
+
+        if (pow_mod(p->omega, 64, p->q) != p->q - 1) {
+            printf("%s: omega %llu does not have order 128\n", p->name, (unsigned long long)p->omega);
+            return 1;
+        }
+
+        for (int poly = 0; poly < VECTOR_POLYS; poly++) {
+            uint64_t back[N];
+            make_input(in[poly], poly, p->q);
+            memcpy(out[poly], in[poly], sizeof(out[poly]));
+            ntt_generic(out[poly], p);
+
+            // the hardware inverse must give the input back
+            memcpy(back, out[poly], sizeof(back));
+            intt_generic(back, p);
+            if (memcmp(back, in[poly], sizeof(back)) != 0) {
+                printf("%s: round trip mismatch (poly %d)\n", p->name, poly);
+                errors++;
+            }
+
+            // Kyber: same results as the 16-bit code the rest of the tree uses
+            if (p->q == Q && p->omega == 910) {
+                uint16_t a[N], b[N];
+                uint64_t r[N];
+                for (int i = 0; i < N; i++) a[i] = b[i] = (uint16_t)in[poly][i];
+                ntt_standard(a, N, 910);
+                poly_invntt_ref(b);
+                memcpy(r, in[poly], sizeof(r));
+                intt_generic(r, p);
+                for (int i = 0; i < N; i++) {
+                    if (a[i] != out[poly][i] || b[i] != r[i]) {
+                        printf("%s: mismatch against ntt_standard/poly_invntt_ref (poly %d)\n", p->name, poly);
+                        errors++;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (errors) break;
+        if (write_mem(dir, p->name, "in", in, digits) != 0 ||
+            write_mem(dir, p->name, "ntt", out, digits) != 0)
+            return 1;
+    }
+
+    if (errors) {
+        printf("\nERROR: %d mismatches\n", errors);
+        return 1;
+    }
+    printf("reference transforms agree with ntt_standard, round trips pass\n");
+    return 0;
+}
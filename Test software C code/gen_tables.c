@@ -0,0 +1,452 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// Build-time generator for the NTT constants of one parameter set.
+//
+//   gen_tables <name> <q> <n> <plain|barrett|montgomery> [omega] [output directory]
+//
+// writes
+//   <name>_consts.h        moduli, roots, Montgomery/Barrett constants, table and kernel declarations
+//   <name>_consts.c        const twiddle tables and straight-line NTT/INTT kernels
+//   <name>_twiddle_rom.svh the case items of twiddle_ROM.sv (Kyber: committed to verilog/source
+//                          and included there, make check_rom compares)
+//   <name>_twiddle_rom.mem the same ROM as $readmemh data
+//
+// The transform is the one ntt_standard/intt_standard and the hardware run: n points,
+// forward twiddles omega^bitrev(i), inverse twiddles omega^-bitrev(i), i < n/2, a halving
+// after every inverse stage. omega must have order n/2 (Kyber: 910); the default is the
+// smallest such element. The reduction style picks the multiplication the unrolled kernels
+// are built on; every style gives the same canonical results.
+// Coefficients are uint16_t with R = 2^16 for q < 2^15, uint32_t with R = 2^32 up to 2^30.
+
+typedef enum { STYLE_PLAIN, STYLE_BARRETT, STYLE_MONTGOMERY } reduction_style;
+static const char *style_names[] = {"plain", "barrett", "montgomery"};
+
+typedef struct {
+    const char *name;
+    char upper[64];
+    uint64_t q, n, omega, omega_inv;
+    int logn;
+    reduction_style style;
+    int r_bits;                 //Montgomery R = 2^r_bits, also the coefficient width
+    uint64_t qinv, qinv_neg, rinv, r2;
+    int barrett_k;
+    uint64_t barrett_mu;
+    uint64_t *zetas[2];         //[0] forward, [1] inverse
+    const char *dir;
+    const char *cmdline;
+} params;
+
+static uint64_t pow_mod(uint64_t b, uint64_t e, uint64_t q) {
+    uint64_t r = 1;
+    b %= q;
+    while (e) {
+        if (e & 1) r = r * b % q;
+        b = b * b % q;
+        e >>= 1;
+    }
+    return r;
+}
+
+static int bit_reverse(int x, int bits) {
+    int r = 0;
+    for (int i = 0; i < bits; i++) r = (r << 1) | ((x >> i) & 1);
+    return r;
+}
+
+static int bit_length(uint64_t x) {
+    int k = 0;
+    while (x) { k++; x >>= 1; }
+    return k;
+}
+
+static int is_prime(uint64_t q) {
+    if (q < 3 || !(q & 1)) return 0;
+    for (uint64_t d = 3; d * d <= q; d += 2)
+        if (q % d == 0) return 0;
+    return 1;
+}
+
+static int has_order(uint64_t w, uint64_t order, uint64_t q) {
+    // order is a power of two: w^(order/2) = -1
+    return order >= 2 && pow_mod(w, order / 2, q) == q - 1;
+}
+
+// x^-1 mod 2^bits for odd x, Newton iteration
+static uint64_t inv_pow2(uint64_t x, int bits) {
+    uint64_t y = 1;
+    for (int i = 0; i < 6; i++) y *= 2 - x * y;
+    return bits == 64 ? y : y & ((1ull << bits) - 1);
+}
+
+// -----------------------------------------------------------------------------
+// Self-check: the generic transform with these twiddles must round trip
+// -----------------------------------------------------------------------------
+static uint64_t half_mod(uint64_t x, uint64_t q) {
+    return (x & 1) ? (q - 1) / 2 + (x + 1) / 2 : x / 2;
+}
+
+static int round_trip(const params *p) {
+    uint64_t *a = malloc(p->n * sizeof(uint64_t)), *b = malloc(p->n * sizeof(uint64_t));
+    int ok = 1;
+    for (uint64_t i = 0; i < p->n; i++) a[i] = b[i] = (i * 2654435761u + 12345) % p->q;
+
+    for (uint64_t len = p->n / 2; len >= 1; len >>= 1) {
+        uint64_t step = p->n / (2 * len);
+        for (uint64_t s = 0; s < p->n; s += 2 * len)
+            for (uint64_t j = 0; j < len; j++) {
+                uint64_t u = a[s + j], v = a[s + j + len] * p->zetas[0][j * step] % p->q;
+                a[s + j] = (u + v) % p->q;
+                a[s + j + len] = (u + p->q - v) % p->q;
+            }
+    }
+    for (uint64_t len = 1; len < p->n; len <<= 1) {
+        uint64_t step = p->n / (2 * len);
+        for (uint64_t s = 0; s < p->n; s += 2 * len)
+            for (uint64_t j = 0; j < len; j++) {
+                uint64_t u = a[s + j], v = a[s + j + len];
+                a[s + j] = half_mod((u + v) % p->q, p->q);
+                a[s + j + len] = half_mod((u + p->q - v) % p->q * p->zetas[1][j * step] % p->q, p->q);
+            }
+    }
+    for (uint64_t i = 0; i < p->n; i++) ok &= a[i] == b[i];
+    free(a);
+    free(b);
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+// Output
+// -----------------------------------------------------------------------------
+static FILE *open_out(const params *p, const char *suffix) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s%s", p->dir, p->name, suffix);
+    FILE *f = fopen(path, "w");
+    if (!f) printf("cannot write %s\n", path);
+    return f;
+}
+
+static const char *coeff_type(const params *p) {
+    return p->r_bits == 16 ? "uint16_t" : "uint32_t";
+}
+
+// twiddle as the unrolled kernel multiplies with it
+static uint64_t kernel_twiddle(const params *p, int m, uint64_t i) {
+    uint64_t z = p->zetas[m][i];
+    return p->style == STYLE_MONTGOMERY ? (z << p->r_bits) % p->q : z;
+}
+
+static void write_table(FILE *f, const params *p, const char *suffix, int mont, int qinv) {
+    fprintf(f, "const %s %s_%s[2][%s_N / 2] = {\n", coeff_type(p), p->name, suffix, p->upper);
+    for (int m = 0; m < 2; m++) {
+        fprintf(f, "    {");
+        for (uint64_t i = 0; i < p->n / 2; i++) {
+            uint64_t z = p->zetas[m][i];
+            if (mont) z = (z << p->r_bits) % p->q;
+            if (qinv) z = z * p->qinv & ((1ull << p->r_bits) - 1);
+            if (i % 12 == 0) fprintf(f, "\n        ");
+            fprintf(f, "%llu%s", (unsigned long long)z, i + 1 < p->n / 2 ? ", " : "");
+        }
+        fprintf(f, "\n    }%s\n", m == 0 ? "," : "");
+    }
+    fprintf(f, "};\n\n");
+}
+
+static int write_header(const params *p) {
+    FILE *f = open_out(p, "_consts.h");
+    const char *U = p->upper;
+    if (!f) return -1;
+
+    fprintf(f, "// Generated by %s -- do not edit.\n", p->cmdline);
+    fprintf(f, "#ifndef %s_CONSTS_H\n#define %s_CONSTS_H\n\n#include <stdint.h>\n\n", U, U);
+    fprintf(f, "#define %s_Q           %llu\n", U, (unsigned long long)p->q);
+    fprintf(f, "#define %s_N           %llu\n", U, (unsigned long long)p->n);
+    fprintf(f, "#define %s_LOGN        %d\n", U, p->logn);
+    fprintf(f, "#define %s_OMEGA       %llu //order N/2, forward twiddles OMEGA^bitrev(i)\n", U, (unsigned long long)p->omega);
+    fprintf(f, "#define %s_OMEGA_INV   %llu //inverse twiddles\n", U, (unsigned long long)p->omega_inv);
+    fprintf(f, "#define %s_HALF        %llu //(Q - 1) / 2: x / 2 mod Q = HALF + (x + 1) / 2 for odd x\n", U, (unsigned long long)((p->q - 1) / 2));
+    fprintf(f, "#define %s_MONT_R_BITS %d //Montgomery R = 2^R_BITS\n", U, p->r_bits);
+    fprintf(f, "#define %s_QINV        %lluu //Q^-1 mod R\n", U, (unsigned long long)p->qinv);
+    fprintf(f, "#define %s_QINV_NEG    %lluu //-Q^-1 mod R\n", U, (unsigned long long)p->qinv_neg);
+    fprintf(f, "#define %s_RINV        %llu //R^-1 mod Q\n", U, (unsigned long long)p->rinv);
+    fprintf(f, "#define %s_R2          %llu //R^2 mod Q\n", U, (unsigned long long)p->r2);
+    fprintf(f, "#define %s_BARRETT_K   %d //bit length of Q\n", U, p->barrett_k);
+    fprintf(f, "#define %s_BARRETT_MU  %llu //floor(4^K / Q)\n", U, (unsigned long long)p->barrett_mu);
+    fprintf(f, "#define %s_REDUCTION   \"%s\" //multiplication used by the unrolled kernels\n\n", U, style_names[p->style]);
+
+    fprintf(f, "// [0] forward (OMEGA), [1] inverse (OMEGA_INV): zetas[m][i] = omega^bitrev(i)\n");
+    fprintf(f, "extern const %s %s_zetas[2][%s_N / 2];\n", coeff_type(p), p->name, U);
+    fprintf(f, "// Montgomery forms: zetas * R mod Q, and that times QINV mod R\n");
+    fprintf(f, "extern const %s %s_zetas_mont[2][%s_N / 2];\n", coeff_type(p), p->name, U);
+    fprintf(f, "extern const %s %s_zetas_mont_qinv[2][%s_N / 2];\n\n", coeff_type(p), p->name, U);
+
+    fprintf(f, "// ntt_standard(a, N, OMEGA) and intt_standard(a, N, OMEGA_INV) as straight-line code,\n");
+    fprintf(f, "// in place, coefficients in [0, Q)\n");
+    fprintf(f, "void %s_ntt_unrolled(%s *a);\n", p->name, coeff_type(p));
+    fprintf(f, "void %s_intt_unrolled(%s *a);\n\n#endif\n", p->name, coeff_type(p));
+    fclose(f);
+    return 0;
+}
+
+// The twiddle of a butterfly depends only on its offset j in the block, so each stage is
+// one block of butterflies with immediate twiddles, looped over the blocks: n/2 + ... + 1
+// butterflies of code per direction instead of (n/2) log n, which stays in the L1 I-cache.
+static void write_stage_head(FILE *f, const params *p, int inverse, int stage, uint64_t len, const char *note) {
+    fprintf(f, "// len %llu%s\nstatic void %s_stage_%d(coeff *a) {\n", (unsigned long long)len, note,
+            inverse ? "intt" : "ntt", stage);
+    fprintf(f, "    for (int s = 0; s < %s_N; s += %llu) {\n        coeff *b = a + s;\n", p->upper,
+            (unsigned long long)(2 * len));
+}
+
+// plain and Barrett: every operation returns [0, Q), twiddle 1 skips the multiplication
+static void write_exact_stages(FILE *f, const params *p) {
+    fprintf(f, "#define BF(i, j, w) do { coeff u = b[i], v = mul(b[j], w); b[i] = add(u, v); b[j] = sub(u, v); } while (0)\n");
+    fprintf(f, "#define BF1(i, j) do { coeff u = b[i], v = b[j]; b[i] = add(u, v); b[j] = sub(u, v); } while (0)\n");
+    fprintf(f, "#define IBF(i, j, w) do { coeff u = b[i], v = b[j]; b[i] = half(add(u, v)); b[j] = half(mul(sub(u, v), w)); } while (0)\n");
+    fprintf(f, "#define IBF1(i, j) do { coeff u = b[i], v = b[j]; b[i] = half(add(u, v)); b[j] = half(sub(u, v)); } while (0)\n\n");
+
+    for (int m = 0; m < 2; m++) {
+        int stage = 0;
+        for (uint64_t len = m ? 1 : p->n / 2; m ? len < p->n : len >= 1; len = m ? len << 1 : len >> 1, stage++) {
+            uint64_t step = p->n / (2 * len);
+            write_stage_head(f, p, m, stage, len, "");
+            for (uint64_t j = 0; j < len; j++) {
+                if (p->zetas[m][j * step] == 1)
+                    fprintf(f, "        %s1(%llu, %llu);\n", m ? "IBF" : "BF", (unsigned long long)j,
+                            (unsigned long long)(j + len));
+                else
+                    fprintf(f, "        %s(%llu, %llu, %lluu);\n", m ? "IBF" : "BF", (unsigned long long)j,
+                            (unsigned long long)(j + len), (unsigned long long)kernel_twiddle(p, m, j * step));
+            }
+            fprintf(f, "    }\n}\n\n");
+        }
+    }
+}
+
+// Montgomery: no correction inside a butterfly. mul returns [0, 2Q) for any coefficient, sums
+// grow by a known multiple of Q per stage; the generator tracks that bound B (exclusive) and
+// reduces to [0, Q) once at the end, or earlier when the next stage would leave the word.
+// Forward: u + v, u - v + 2Q < B + 2Q. Inverse: u - v + K with K = ceil(B / Q) * Q >= B keeps
+// the difference positive and below B + K, both halvings stay below B + (Q + 1) / 2.
+// reduce_before[m] bit i: stage i of direction m starts with reduce_all
+static void write_lazy_stages(FILE *f, const params *p, uint32_t reduce_before[2]) {
+    uint64_t limit = 1ull << p->r_bits, q = p->q, bound;
+    char note[64];
+
+    fprintf(f, "#define BF(i, j, w) do { coeff u = b[i], v = mul(b[j], w); b[i] = u + v; b[j] = u - v + 2 * %s_Q; } while (0)\n", p->upper);
+    fprintf(f, "#define IBF(i, j, w, k) do { coeff u = b[i], v = b[j]; b[i] = half(u + v); b[j] = half(mul(u - v + (k), w)); } while (0)\n\n");
+    fprintf(f, "static void reduce_all(coeff *a) {\n"
+               "    for (int i = 0; i < %s_N; i++) a[i] = (coeff)(a[i] %% %s_Q);\n}\n\n", p->upper, p->upper);
+
+    for (int m = 0; m < 2; m++) {
+        int stage = 0;
+        bound = q;
+        for (uint64_t len = m ? 1 : p->n / 2; m ? len < p->n : len >= 1; len = m ? len << 1 : len >> 1, stage++) {
+            uint64_t step = p->n / (2 * len), k = (bound + q - 1) / q * q;
+            int reduce = m ? (2 * bound > limit || bound + k > limit) : bound + 2 * q > limit;
+            if (reduce) {
+                reduce_before[m] |= 1u << stage;
+                bound = q;
+                k = q;
+            }
+            bound += m ? (q + 1) / 2 : 2 * q;
+            snprintf(note, sizeof(note), "%s, then below %lluQ", reduce ? ", input reduced first" : "",
+                     (unsigned long long)((bound + q - 1) / q));
+            write_stage_head(f, p, m, stage, len, note);
+            for (uint64_t j = 0; j < len; j++) {
+                if (m)
+                    fprintf(f, "        IBF(%llu, %llu, %lluu, %lluu);\n", (unsigned long long)j, (unsigned long long)(j + len),
+                            (unsigned long long)kernel_twiddle(p, m, j * step), (unsigned long long)k);
+                else
+                    fprintf(f, "        BF(%llu, %llu, %lluu);\n", (unsigned long long)j, (unsigned long long)(j + len),
+                            (unsigned long long)kernel_twiddle(p, m, j * step));
+            }
+            fprintf(f, "    }\n}\n\n");
+        }
+    }
+}
+
+static int write_source(const params *p) {
+    FILE *f = open_out(p, "_consts.c");
+    const char *U = p->upper;
+    const char *wide = p->r_bits == 16 ? "uint32_t" : "uint64_t";
+    const char *sword = p->r_bits == 16 ? "int32_t" : "int64_t";
+    int sword_bits = p->r_bits == 16 ? 32 : 64;
+    if (!f) return -1;
+
+    fprintf(f, "// Generated by %s -- do not edit.\n", p->cmdline);
+    fprintf(f, "#include \"%s_consts.h\"\n\n", p->name);
+    write_table(f, p, "zetas", 0, 0);
+    write_table(f, p, "zetas_mont", 1, 0);
+    write_table(f, p, "zetas_mont_qinv", 1, 1);
+
+    // branch-free helpers: a conditional correction is a masked add of Q, the sign
+    // comes from an arithmetic shift of a signed word wide enough for 2Q
+    fprintf(f, "typedef %s coeff;\ntypedef %s wide;\ntypedef %s sword;\n", coeff_type(p), wide, sword);
+    fprintf(f, "#define SIGN_SHIFT %d\n\n", sword_bits - 1);
+    fprintf(f, "static inline coeff add(coeff a, coeff b) {\n"
+               "    sword r = (sword)a + b - %s_Q;\n"
+               "    return (coeff)(r + ((r >> SIGN_SHIFT) & %s_Q));\n}\n\n", U, U);
+    fprintf(f, "static inline coeff sub(coeff a, coeff b) {\n"
+               "    sword r = (sword)a - b;\n"
+               "    return (coeff)(r + ((r >> SIGN_SHIFT) & %s_Q));\n}\n\n", U);
+    fprintf(f, "static inline coeff half(coeff a) {\n"
+               "    return (coeff)((a >> 1) + (a & 1) * (%s_HALF + 1));\n}\n\n", U);
+
+    switch (p->style) {
+    case STYLE_PLAIN:
+        fprintf(f, "// a * w mod Q\n"
+                   "static inline coeff mul(coeff a, coeff w) {\n"
+                   "    return (coeff)((wide)a * w %% %s_Q);\n}\n\n", U);
+        break;
+    case STYLE_BARRETT:
+        fprintf(f, "// a * w mod Q, quotient ((t >> (K - 1)) * MU) >> (K + 1) is at most 2 short\n"
+                   "static inline coeff mul(coeff a, coeff w) {\n"
+                   "    wide t = (wide)a * w;\n"
+                   "    wide qt = ((t >> (%s_BARRETT_K - 1)) * %s_BARRETT_MU) >> (%s_BARRETT_K + 1);\n"
+                   "    sword r = (sword)(t - qt * %s_Q) - %s_Q;\n"
+                   "    r += (r >> SIGN_SHIFT) & %s_Q;\n"
+                   "    r -= %s_Q;\n"
+                   "    return (coeff)(r + ((r >> SIGN_SHIFT) & %s_Q));\n}\n\n", U, U, U, U, U, U, U, U);
+        break;
+    case STYLE_MONTGOMERY:
+        // (a * w + m * Q) / R < 2Q for any coefficient a < R and w < Q, so the result needs no
+        // correction and the kernels can reduce lazily
+        fprintf(f, "// a * w * R^-1 mod Q in [0, 2Q) for any a, w is a twiddle in Montgomery form\n"
+                   "static inline coeff mul(coeff a, coeff w) {\n"
+                   "    wide t = (wide)a * w;\n"
+                   "    coeff m = (coeff)((coeff)t * %s_QINV_NEG);\n"
+                   "    return (coeff)((t + (wide)m * %s_Q) >> %s_MONT_R_BITS);\n}\n\n", U, U, U);
+        break;
+    }
+
+    uint32_t reduce_before[2] = {0, 0};
+    int lazy = p->style == STYLE_MONTGOMERY;
+    if (lazy) write_lazy_stages(f, p, reduce_before);
+    else write_exact_stages(f, p);
+
+    for (int m = 0; m < 2; m++) {
+        fprintf(f, "void %s_%s_unrolled(coeff *a) {\n", p->name, m ? "intt" : "ntt");
+        for (int i = 0; i < p->logn; i++) {
+            if (reduce_before[m] >> i & 1) fprintf(f, "    reduce_all(a);\n");
+            fprintf(f, "    %s_stage_%d(a);\n", m ? "intt" : "ntt", i);
+        }
+        if (lazy) fprintf(f, "    reduce_all(a);\n");
+        fprintf(f, "}\n%s", m ? "" : "\n");
+    }
+    fclose(f);
+    return 0;
+}
+
+// twiddle_ROM layout: entry i < n/2 forward, n/2 + i inverse
+static int write_rom(const params *p) {
+    FILE *svh = open_out(p, "_twiddle_rom.svh");
+    FILE *mem = open_out(p, "_twiddle_rom.mem");
+    int width = bit_length(p->q - 1), digits = (width + 3) / 4;
+    char label[32], longest[32];
+    if (!svh || !mem) {
+        if (svh) fclose(svh);
+        if (mem) fclose(mem);
+        return -1;
+    }
+
+    fprintf(svh, "// Generated by %s -- do not edit.\n", p->cmdline);
+    fprintf(svh, "// case items of twiddle_ROM.sv: entry i < n/2 forward, n/2 + i inverse\n");
+    snprintf(longest, sizeof(longest), "%d'd%llu:", p->logn, (unsigned long long)(p->n - 1));
+    for (uint64_t a = 0; a < p->n; a++) {
+        uint64_t z = p->zetas[a >= p->n / 2][a % (p->n / 2)];
+        snprintf(label, sizeof(label), "%d'd%llu:", p->logn, (unsigned long long)a);
+        fprintf(svh, "            %-*srom_data = %d'd%llu;\n", (int)strlen(longest) + 1, label, width,
+                (unsigned long long)z);
+        fprintf(mem, "%0*llx\n", digits, (unsigned long long)z);
+    }
+    fclose(svh);
+    fclose(mem);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    params p;
+    char cmdline[256];
+
+    if (argc < 5) {
+        printf("usage: %s <name> <q> <n> <plain|barrett|montgomery> [omega] [output directory]\n", argv[0]);
+        return 1;
+    }
+    memset(&p, 0, sizeof(p));
+    p.name = argv[1];
+    p.q = strtoull(argv[2], NULL, 0);
+    p.n = strtoull(argv[3], NULL, 0);
+    p.dir = argc > 6 ? argv[6] : ".";
+
+    for (size_t i = 0; p.name[i] && i + 1 < sizeof(p.upper); i++) {
+        if (!isalnum((unsigned char)p.name[i]) && p.name[i] != '_') {
+            printf("name must be a C identifier\n");
+            return 1;
+        }
+        p.upper[i] = (char)toupper((unsigned char)p.name[i]);
+    }
+
+    p.style = (reduction_style)-1;
+    for (int s = 0; s < 3; s++)
+        if (strcmp(argv[4], style_names[s]) == 0) p.style = (reduction_style)s;
+    if ((int)p.style < 0) {
+        printf("unknown reduction style %s\n", argv[4]);
+        return 1;
+    }
+
+    if (!is_prime(p.q) || p.q >= (1ull << 30)) {
+        printf("q must be an odd prime below 2^30\n");
+        return 1;
+    }
+    p.logn = bit_length(p.n) - 1;
+    if (p.n < 4 || p.n > 4096 || (p.n & (p.n - 1)) || (p.q - 1) % (p.n / 2)) {
+        printf("n must be a power of two in [4, 4096] with n/2 dividing q - 1\n");
+        return 1;
+    }
+
+    // root of order n/2
+    if (argc > 5 && strcmp(argv[5], "-") != 0) {
+        p.omega = strtoull(argv[5], NULL, 0) % p.q;
+        if (!has_order(p.omega, p.n / 2, p.q)) {
+            printf("omega %llu does not have order n/2 = %llu mod %llu\n", (unsigned long long)p.omega,
+                   (unsigned long long)(p.n / 2), (unsigned long long)p.q);
+            return 1;
+        }
+    } else {
+        for (p.omega = 2; p.omega < p.q && !has_order(p.omega, p.n / 2, p.q); p.omega++) ;
+    }
+    p.omega_inv = pow_mod(p.omega, p.q - 2, p.q);
+
+    p.r_bits = p.q < (1u << 15) ? 16 : 32;
+    p.qinv = inv_pow2(p.q, p.r_bits);
+    p.qinv_neg = ((1ull << p.r_bits) - p.qinv) & ((1ull << p.r_bits) - 1);
+    p.rinv = pow_mod(pow_mod(2, p.r_bits, p.q), p.q - 2, p.q);
+    p.r2 = pow_mod(2, 2 * p.r_bits, p.q);
+    p.barrett_k = bit_length(p.q);
+    p.barrett_mu = (1ull << (2 * p.barrett_k)) / p.q;
+
+    for (int m = 0; m < 2; m++) {
+        p.zetas[m] = malloc(p.n / 2 * sizeof(uint64_t));
+        for (uint64_t i = 0; i < p.n / 2; i++)
+            p.zetas[m][i] = pow_mod(m ? p.omega_inv : p.omega, bit_reverse((int)i, p.logn - 1), p.q);
+    }
+    if (!round_trip(&p)) {
+        printf("the transform with omega %llu does not round trip\n", (unsigned long long)p.omega);
+        return 1;
+    }
+
+    snprintf(cmdline, sizeof(cmdline), "gen_tables %s %llu %llu %s %llu", p.name, (unsigned long long)p.q,
+             (unsigned long long)p.n, style_names[p.style], (unsigned long long)p.omega);
+    p.cmdline = cmdline;
+
+    if (write_header(&p) || write_source(&p) || write_rom(&p)) return 1;
+    printf("%s: q = %llu, n = %llu, omega = %llu, %s kernels\n", p.name, (unsigned long long)p.q,
+           (unsigned long long)p.n, (unsigned long long)p.omega, style_names[p.style]);
+    free(p.zetas[0]);
+    free(p.zetas[1]);
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include "ntt.h"
+#include "poly_arena.h"
 
 int main(int argc, char *argv[]) {
     if (argc < 3) {
@@ -10,8 +11,13 @@ int main(int argc, char *argv[]) {
     }
 
     int n = atoi(argv[1]);
-    if (n <= 0 || (n & (n - 1)) != 0) {
-        fprintf(stderr, "Length must be a power of 2.\n");
+    if (n < 2 || (n & (n - 1)) != 0) {
+        fprintf(stderr, "Length must be a power of 2, at least 2.\n");
+        return 1;
+    }
+
+    if (n > KYBER_POL_LENGTH) {
+        fprintf(stderr, "Length must be at most %d.\n", KYBER_POL_LENGTH);
         return 1;
     }
 
@@ -20,11 +26,13 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    uint16_t *a = malloc(sizeof(uint16_t) * n);
-    if (!a) {
-        perror("malloc error");
+    poly_arena *arena = poly_arena_thread();
+    poly *p = arena ? poly_alloc(arena) : NULL;
+    if (!p) {
+        fprintf(stderr, "arena allocation error\n");
         return 1;
     }
+    uint16_t *a = p->coeffs;
 
     for (int i = 0; i < n; i++) {
         a[i] = (uint16_t)atoi(argv[i + 2]) % Q;
@@ -45,6 +53,6 @@ int main(int argc, char *argv[]) {
     for (int i = 0; i < n; i++) printf("%d ", a[i]);
     printf("\n");
 
-    free(a);
+    poly_arena_reset(arena);
     return 0;
 }
@@ -3,10 +3,11 @@
 
 #include <stdint.h>
 #include "kyber_params.h"
+#include "kyber_consts.h" //generated by gen_tables
 
-#define _R 65536
-#define RINV 169
-#define QINV 3327
+#define _R   (1u << KYBER_MONT_R_BITS)
+#define RINV KYBER_RINV     //R^-1 mod Q
+#define QINV KYBER_QINV_NEG //-Q^-1 mod R
 
 
 uint16_t montgomery_reduce(uint32_t T, uint16_t q, uint16_t qinv, uint32_t R);
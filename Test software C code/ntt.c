@@ -1,5 +1,11 @@
 #include "ntt.h"
+#include "kyber_consts.h"
 #include <stdio.h>
+#include <stdlib.h>
+
+#if KYBER_Q != Q || KYBER_N != KYBER_POL_LENGTH
+#error "kyber_consts.h does not match kyber_params.h"
+#endif
 
 uint16_t mod_add(uint16_t a, uint16_t b) {
     uint16_t r = a + b;
@@ -49,23 +55,49 @@ uint16_t find_primitive_2nth_root(int n) {
     return 0; // not found
 }
 
-void ntt_standard(uint16_t *a, int n, uint16_t omega) {
-    int log_n = 0;
-    for (int temp = n; temp > 1; temp >>= 1) log_n++;
+// Twiddle factors in bit-reversed order, zetas[i] = omega^bitrev(i).
+// A power-of-two NTT over Q needs n | Q - 1 = 2^8 * 13, so n <= KYBER_POL_LENGTH and the
+// table has a fixed size. The transforms the hardware runs come from the generated tables
+// (gen_tables), any other (n, omega) is computed once per thread, not on every call.
+typedef struct {
+    int n;
+    uint16_t omega;
+    uint16_t zetas[KYBER_POL_LENGTH / 2];
+} twiddle_table;
+
+// n outside [2, KYBER_POL_LENGTH] or not a power of two is a caller bug: there is no
+// table for it and transforming nothing would hand back the input unchanged, so stop here
+static const uint16_t *twiddles(twiddle_table *t, int n, uint16_t omega) {
+    if (n < 2 || n > KYBER_POL_LENGTH || (n & (n - 1)) != 0) {
+        fprintf(stderr, "ntt: unsupported transform length %d (power of two, 2 .. %d)\n", n, KYBER_POL_LENGTH);
+        abort();
+    }
+    if (n == KYBER_N && omega == KYBER_OMEGA) return kyber_zetas[0];
+    if (n == KYBER_N && omega == KYBER_OMEGA_INV) return kyber_zetas[1];
 
-    // Precompute twiddle factors (powers of omega)
-    uint16_t zetas[n / 2];
-    for (int i = 0; i < n / 2; i++) {
-        int rev = bit_reverse(i, log_n - 1);
-        zetas[i] = mod_pow(omega, rev);
+    if (t->n != n || t->omega != omega) {
+        int log_n = 0;
+        for (int temp = n; temp > 1; temp >>= 1) log_n++;
+
+        for (int i = 0; i < n / 2; i++) {
+            int rev = bit_reverse(i, log_n - 1);
+            t->zetas[i] = mod_pow(omega, rev);
+        }
+        t->n = n;
+        t->omega = omega;
     }
+    return t->zetas;
+}
+
+static _Thread_local twiddle_table ntt_twiddles, intt_twiddles;
+
+void ntt_standard(uint16_t *a, int n, uint16_t omega) {
+    // Precompute twiddle factors (powers of omega)
+    const uint16_t *zetas = twiddles(&ntt_twiddles, n, omega);
 
     // DIT NTT
-    int stage = 0;
     for (int len = n / 2; len >= 1; len >>= 1) {
         int step = n / (2 * len);
-        //stage++;
-        //printf("stage %d:\n", stage);
         for (int start = 0; start < n; start += 2 * len) {
             for (int j = 0; j < len; j++) {
                 int pos = start + j;
@@ -87,15 +119,8 @@ void ntt_standard(uint16_t *a, int n, uint16_t omega) {
 }
 
 void intt_standard(uint16_t *a, int n, uint16_t omega) {
-    int log_n = 0;
-    for (int temp = n; temp > 1; temp >>= 1) log_n++;
-
     // Precompute twiddle factors in bit-reversed order
-    uint16_t zetas[n / 2];
-    for (int i = 0; i < n / 2; i++) {
-        int rev = bit_reverse(i, log_n - 1);
-        zetas[i] = mod_pow(omega, rev);
-    }
+    const uint16_t *zetas = twiddles(&intt_twiddles, n, omega);
 
     // Gentleman-Sande INTT
     int stage = 0;
@@ -131,23 +156,14 @@ void intt_standard(uint16_t *a, int n, uint16_t omega) {
     }*/
 }
 
+// no primitive 2n-th root exists for n = 256 (512 does not divide Q - 1), the
+// hardware transform with the generated root of order n/2 is used instead
 void ntt_negacyclic(uint16_t *a, int n) {
-    uint16_t zeta = find_primitive_2nth_root(n);
-    uint16_t omega = mod_pow(zeta, 2);
-
-
-    ntt_standard(a, n, 910);
-
-    //printf("zeta = %d\n", zeta);
+    ntt_standard(a, n, KYBER_OMEGA);
 }
 
 void intt_negacyclic(uint16_t *a, int n) {
-    uint16_t zeta = find_primitive_2nth_root(n);
-    uint16_t omega_inv = mod_pow(mod_pow(zeta, 2), Q - 2);
-    uint16_t zeta_inv = mod_pow(zeta, Q - 2);
-
-    intt_standard(a, n, 3040);
-
+    intt_standard(a, n, KYBER_OMEGA_INV);
 }
 
 // Reverse the bits of index 'x' with 'log_n' bits
@@ -0,0 +1,128 @@
+#include "ntt_batch.h"
+#include "ntt.h"
+#include "poly_ntt.h"
+#include "kyber_consts.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define N 256
+
+void ntt_batch_ref(uint16_t *const *polys, int count, int mode) {
+    for (int p = 0; p < count; p++) {
+        if (mode == NTT_BATCH_INVERSE)
+            poly_invntt_ref(polys[p]);
+        else
+            poly_ntt_ref(polys[p]);
+    }
+}
+
+#if defined(__AVX2__)
+// Twiddles zetas[i] = omega^bitrev7(i) as in ntt_standard, in the Montgomery forms the
+// SIMD kernel multiplies with, generated at build time (gen_tables, kyber_consts.h):
+//   kyber_zetas_mont[m][i]      = zetas[i] * 2^16 mod Q
+//   kyber_zetas_mont_qinv[m][i] = kyber_zetas_mont[m][i] * Q^-1 mod 2^16
+#if KYBER_Q != Q || KYBER_N != N || KYBER_MONT_R_BITS != 16
+#error "kyber_consts.h does not match kyber_params.h"
+#endif
+
+// -----------------------------------------------------------------------------
+// AVX2 kernel: x[i] holds coefficient i of NTT_BATCH_LANES polynomials.
+// Values stay canonical in [0, Q); for unsigned 16-bit x < 2Q,
+// min(x, x - Q) is x mod Q because x - Q wraps around when x < Q.
+// -----------------------------------------------------------------------------
+static inline __m256i addq(__m256i a, __m256i b, __m256i q) {
+    __m256i s = _mm256_add_epi16(a, b);
+    return _mm256_min_epu16(s, _mm256_sub_epi16(s, q));
+}
+
+static inline __m256i subq(__m256i a, __m256i b, __m256i q) {
+    __m256i d = _mm256_add_epi16(_mm256_sub_epi16(a, b), q);
+    return _mm256_min_epu16(d, _mm256_sub_epi16(d, q));
+}
+
+// a * zeta mod Q by Montgomery reduction of a * (zeta * 2^16), lands in (-Q, Q)
+static inline __m256i mulq(__m256i a, int16_t mont, int16_t qinv, __m256i q) {
+    __m256i hi = _mm256_mulhi_epi16(a, _mm256_set1_epi16(mont));
+    __m256i m = _mm256_mullo_epi16(a, _mm256_set1_epi16(qinv));
+    __m256i r = _mm256_add_epi16(_mm256_sub_epi16(hi, _mm256_mulhi_epi16(m, q)), q);
+    return _mm256_min_epu16(r, _mm256_sub_epi16(r, q));
+}
+
+static inline __m256i halfq(__m256i x, __m256i q) {
+    __m256i odd = _mm256_and_si256(x, _mm256_set1_epi16(1));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_mullo_epi16(odd, q)), 1);
+}
+
+static void ntt_lanes_avx2(__m256i *x, int mode) {
+    const __m256i q = _mm256_set1_epi16(Q);
+
+    if (mode != NTT_BATCH_INVERSE) {
+        for (int len = N / 2; len >= 1; len >>= 1) {
+            int step = N / (2 * len);
+            for (int start = 0; start < N; start += 2 * len) {
+                for (int j = 0; j < len; j++) {
+                    int pos = start + j;
+                    __m256i u = x[pos];
+                    __m256i v = mulq(x[pos + len], (int16_t)kyber_zetas_mont[0][j * step],
+                                     (int16_t)kyber_zetas_mont_qinv[0][j * step], q);
+                    x[pos] = addq(u, v, q);
+                    x[pos + len] = subq(u, v, q);
+                }
+            }
+        }
+        return;
+    }
+
+    for (int len = 1; len < N; len <<= 1) {
+        int step = N / (2 * len);
+        for (int start = 0; start < N; start += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                int pos = start + j;
+                __m256i u = x[pos];
+                __m256i v = x[pos + len];
+                x[pos] = halfq(addq(u, v, q), q);
+                x[pos + len] = halfq(mulq(subq(u, v, q), (int16_t)kyber_zetas_mont[1][j * step],
+                                              (int16_t)kyber_zetas_mont_qinv[1][j * step], q), q);
+            }
+        }
+    }
+}
+
+// transposes up to NTT_BATCH_LANES polynomials in, transforms, transposes back;
+// unused lanes are zero
+static void ntt_group_avx2(uint16_t *const *polys, int count, int mode) {
+    uint16_t lanes[N][NTT_BATCH_LANES] __attribute__((aligned(32)));
+    __m256i x[N];
+
+    if (count < NTT_BATCH_LANES) memset(lanes, 0, sizeof(lanes));
+    for (int p = 0; p < count; p++)
+        for (int i = 0; i < N; i++) lanes[i][p] = polys[p][i];
+    for (int i = 0; i < N; i++) x[i] = _mm256_load_si256((const __m256i *)lanes[i]);
+
+    ntt_lanes_avx2(x, mode);
+
+    for (int i = 0; i < N; i++) _mm256_store_si256((__m256i *)lanes[i], x[i]);
+    for (int p = 0; p < count; p++)
+        for (int i = 0; i < N; i++) polys[p][i] = lanes[i][p];
+}
+#endif
+
+void ntt_batch(uint16_t *const *polys, int count, int mode) {
+#if defined(__AVX2__)
+    for (int p = 0; p < count; p += NTT_BATCH_LANES) {
+        int group = count - p < NTT_BATCH_LANES ? count - p : NTT_BATCH_LANES;
+        ntt_group_avx2(polys + p, group, mode);
+    }
+#else
+    // poly_ntt runs the generated straight-line kernels
+    for (int p = 0; p < count; p++) {
+        if (mode == NTT_BATCH_INVERSE)
+            poly_invntt(polys[p]);
+        else
+            poly_ntt(polys[p]);
+    }
+#endif
+}
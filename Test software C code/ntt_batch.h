@@ -0,0 +1,26 @@
+#ifndef NTT_BATCH_H
+#define NTT_BATCH_H
+
+#include <stdint.h>
+#include "kyber_params.h"
+
+// Transforms of many independent 256-coefficient polynomials, in place.
+// Same conventions as the hardware and ntt_standard/intt_standard with n = 256:
+// forward with omega = 910, inverse with omega = 3040 and a halving after every stage.
+// Coefficients are expected in [0, Q) and stay there.
+
+#define NTT_BATCH_LANES 16 //polynomials per SIMD group (one 16-bit lane each)
+
+#define NTT_BATCH_FORWARD 0
+#define NTT_BATCH_INVERSE 1
+
+// SIMD across polynomials when the build enables AVX2: NTT_BATCH_LANES polynomials are
+// transposed so every vector holds the same coefficient of each, then transformed together.
+// A partial last group runs with its unused lanes zeroed. Without AVX2 the polynomials
+// go through poly_ntt/poly_invntt one at a time.
+void ntt_batch(uint16_t *const *polys, int count, int mode);
+
+// scalar reference: one polynomial at a time, no tracing output
+void ntt_batch_ref(uint16_t *const *polys, int count, int mode);
+
+#endif
@@ -0,0 +1,585 @@
+#include "ntt_service.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void ns_to_timespec(uint64_t ns, struct timespec *ts) {
+    ts->tv_sec = (time_t)(ns / 1000000000ull);
+    ts->tv_nsec = (long)(ns % 1000000000ull);
+}
+
+// -----------------------------------------------------------------------------
+// Built-in backends
+// -----------------------------------------------------------------------------
+static void run_scalar(void *ctx, uint16_t *const *polys, int count, int mode) {
+    (void)ctx;
+    ntt_batch_ref(polys, count, mode);
+}
+
+#if defined(__AVX2__)
+static void run_simd(void *ctx, uint16_t *const *polys, int count, int mode) {
+    (void)ctx;
+    ntt_batch(polys, count, mode);
+}
+#endif
+
+// best of a few runs over count polynomials, forward and inverse averaged
+static double time_backend(const ntt_backend *b, uint16_t *const *polys, int count) {
+    uint64_t best = UINT64_MAX;
+    for (int rep = 0; rep < 8; rep++) {
+        uint64_t t0 = now_ns();
+        b->run(b->ctx, polys, count, NTT_BATCH_FORWARD);
+        b->run(b->ctx, polys, count, NTT_BATCH_INVERSE);
+        uint64_t t = now_ns() - t0;
+        if (t < best) best = t;
+    }
+    return best / 2.0;
+}
+
+// fits ns_per_pass and ns_per_poly from one polynomial and one full pass
+static int calibrate(ntt_backend *b) {
+    uint16_t *polys[NTT_SERVICE_MAX_BATCH];
+    int lanes = b->lanes < NTT_SERVICE_MAX_BATCH ? b->lanes : NTT_SERVICE_MAX_BATCH;
+    uint16_t *buf = malloc((size_t)lanes * KYBER_POL_LENGTH * sizeof(uint16_t));
+
+    if (!buf) return -1;
+    for (int p = 0; p < lanes; p++) {
+        polys[p] = buf + p * KYBER_POL_LENGTH;
+        for (int i = 0; i < KYBER_POL_LENGTH; i++) polys[p][i] = (uint16_t)((p * 251 + i * 17) % Q);
+    }
+    double one = time_backend(b, polys, 1) - b->ns_fixed;
+    double full = time_backend(b, polys, lanes) - b->ns_fixed;
+    b->ns_per_poly = (lanes > 1 && full > one) ? (full - one) / (lanes - 1) : 0;
+    b->ns_per_pass = one - b->ns_per_poly;
+    free(buf);
+    return 0;
+}
+
+static double backend_cost(const ntt_backend *b, int count) {
+    int passes = (count + b->lanes - 1) / b->lanes;
+    return b->ns_fixed + b->ns_per_pass * passes + b->ns_per_poly * count;
+}
+
+// -----------------------------------------------------------------------------
+// Batching
+// -----------------------------------------------------------------------------
+// picks the queue to dispatch: one holding a full batch or whose oldest request is
+// past the window (the older head wins). returns 1 with *mode set, 0 with *deadline
+// set to the earliest window end, -1 when nothing is queued. caller holds the lock.
+static int pick_queue(ntt_service *s, uint64_t now, int *mode, uint64_t *deadline, int *full) {
+    uint64_t window = (uint64_t)s->config.window_us * 1000;
+    int found = -1;
+
+    *deadline = UINT64_MAX;
+    for (int m = 0; m < 2; m++) {
+        if (!s->head[m]) continue;
+        uint64_t end = s->head[m]->submit_ns + window;
+        int is_full = s->queued[m] >= s->config.max_batch;
+        if (is_full || end <= now || s->stopping) {
+            if (found < 0 || s->head[m]->submit_ns < s->head[found]->submit_ns) {
+                found = m;
+                *full = is_full;
+            }
+        } else if (end < *deadline) {
+            *deadline = end;
+        }
+    }
+    if (found >= 0) {
+        *mode = found;
+        return 1;
+    }
+    return (*deadline == UINT64_MAX) ? -1 : 0;
+}
+
+static int take_batch(ntt_service *s, int mode, ntt_request **batch) {
+    int n = 0;
+    while (s->head[mode] && n < s->config.max_batch) {
+        batch[n++] = s->head[mode];
+        s->head[mode] = s->head[mode]->next;
+    }
+    if (!s->head[mode]) s->tail[mode] = NULL;
+    s->queued[mode] -= n;
+    return n;
+}
+
+static int pick_backend(const ntt_service *s, int count) {
+    int best = 0;
+    for (int i = 1; i < s->backend_count; i++)
+        if (backend_cost(&s->backends[i], count) < backend_cost(&s->backends[best], count))
+            best = i;
+    return best;
+}
+
+// runs one batch without the lock and completes its requests. a request with a
+// callback may be freed or reused by it, so which ones are waiters is noted first
+// and nothing touches a callback request once its callback has run.
+static void run_batch(ntt_service *s, ntt_request **batch, int n, int mode, int backend) {
+    uint16_t *polys[NTT_SERVICE_MAX_BATCH];
+    uint8_t is_waiter[NTT_SERVICE_MAX_BATCH];
+    const ntt_backend *b = &s->backends[backend];
+    int waiters = 0;
+
+    for (int i = 0; i < n; i++) polys[i] = batch[i]->coeffs;
+    b->run(b->ctx, polys, n, mode);
+
+    uint64_t t = now_ns();
+    for (int i = 0; i < n; i++) {
+        ntt_request *req = batch[i];
+        req->status = NTT_SERVICE_OK;
+        req->complete_ns = t;
+        req->backend = b->name;
+        is_waiter[i] = req->done == NULL;
+        waiters |= is_waiter[i];
+    }
+    for (int i = 0; i < n; i++)
+        if (!is_waiter[i]) batch[i]->done(batch[i], batch[i]->done_arg);    //batch[i] may be gone after this
+
+    if (waiters) {
+        pthread_mutex_lock(&s->lock);
+        for (int i = 0; i < n; i++)
+            if (is_waiter[i]) batch[i]->completed = 1;
+        pthread_cond_broadcast(&s->done);
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+static void *worker_main(void *arg) {
+    ntt_service *s = arg;
+    ntt_request *batch[NTT_SERVICE_MAX_BATCH];
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        int mode = 0, full = 0;
+        uint64_t deadline;
+        int ready = pick_queue(s, now_ns(), &mode, &deadline, &full);
+
+        if (ready < 0) {
+            if (s->stopping) break;
+            pthread_cond_wait(&s->work, &s->lock);
+            continue;
+        }
+        if (ready == 0) {
+            struct timespec ts;
+            ns_to_timespec(deadline, &ts);
+            pthread_cond_timedwait(&s->work, &s->lock, &ts);
+            continue;
+        }
+
+        int n = take_batch(s, mode, batch);
+        int backend = pick_backend(s, n);
+        s->stats.batches++;
+        if (full)
+            s->stats.size_flushes++;
+        else
+            s->stats.deadline_flushes++;
+        s->stats.backend_batches[backend]++;
+        s->stats.backend_polys[backend] += n;
+        // more queued than this batch took: let another worker start on it
+        if (s->head[mode]) pthread_cond_signal(&s->work);
+        pthread_mutex_unlock(&s->lock);
+
+        run_batch(s, batch, n, mode, backend);
+
+        pthread_mutex_lock(&s->lock);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Service
+// -----------------------------------------------------------------------------
+int ntt_service_init(ntt_service *s, const ntt_service_config *config) {
+    ntt_service_config def = {NTT_SERVICE_DEFAULT_BATCH, NTT_SERVICE_DEFAULT_WINDOW_US, 1};
+    pthread_condattr_t attr;
+
+    if (!config) config = &def;
+    if (config->max_batch < 1 || config->max_batch > NTT_SERVICE_MAX_BATCH ||
+        config->window_us < 0 ||
+        config->workers < 1 || config->workers > NTT_SERVICE_MAX_WORKERS)
+        return -1;
+
+    memset(s, 0, sizeof(*s));
+    s->config = *config;
+    s->listen_fd = -1;
+
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);  //deadlines are CLOCK_MONOTONIC
+    pthread_cond_init(&s->work, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_cond_init(&s->done, NULL);
+
+    ntt_backend scalar = {"scalar", 1, run_scalar, NULL, 0, 0, 0};
+    ntt_service_add_backend(s, &scalar);
+#if defined(__AVX2__)
+    ntt_backend avx2 = {"avx2", NTT_BATCH_LANES, run_simd, NULL, 0, 0, 0};
+    ntt_service_add_backend(s, &avx2);
+#endif
+    return 0;
+}
+
+int ntt_service_add_backend(ntt_service *s, const ntt_backend *backend) {
+    if (s->running || s->backend_count == NTT_SERVICE_MAX_BACKENDS) return -1;
+    if (!backend->run || backend->lanes < 1) return -1;
+    s->backends[s->backend_count++] = *backend;
+    return 0;
+}
+
+int ntt_service_start(ntt_service *s) {
+    if (s->running) return -1;
+    for (int i = 0; i < s->backend_count; i++)
+        if (s->backends[i].ns_per_pass <= 0 && s->backends[i].ns_per_poly <= 0 &&
+            calibrate(&s->backends[i]) != 0)
+            return -1;
+
+    for (int i = 0; i < s->config.workers; i++) {
+        if (pthread_create(&s->workers[i], NULL, worker_main, s) != 0) {
+            s->config.workers = i;  //ntt_service_destroy joins the ones that started
+            s->running = 1;
+            return -1;
+        }
+    }
+    s->running = 1;
+    return 0;
+}
+
+static void stop_listening(ntt_service *s);
+
+void ntt_service_destroy(ntt_service *s) {
+    stop_listening(s);
+
+    pthread_mutex_lock(&s->lock);
+    s->stopping = 1;
+    pthread_cond_broadcast(&s->work);
+    pthread_mutex_unlock(&s->lock);
+
+    if (s->running)
+        for (int i = 0; i < s->config.workers; i++) pthread_join(s->workers[i], NULL);
+    s->running = 0;
+
+    pthread_cond_destroy(&s->work);
+    pthread_cond_destroy(&s->done);
+    pthread_mutex_destroy(&s->lock);
+}
+
+// the kernels assume reduced inputs, a coefficient >= Q would come back silently wrong
+static int coeffs_in_range(const uint16_t *coeffs) {
+    uint16_t max = 0;
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) max = coeffs[i] > max ? coeffs[i] : max;
+    return max < Q;
+}
+
+int ntt_service_submit(ntt_service *s, ntt_request *req) {
+    if (!req->coeffs || (req->mode != NTT_BATCH_FORWARD && req->mode != NTT_BATCH_INVERSE) ||
+        !coeffs_in_range(req->coeffs)) {
+        req->status = NTT_SERVICE_EINVAL;
+        return req->status;
+    }
+    req->status = NTT_SERVICE_OK;
+    req->completed = 0;
+    req->backend = NULL;
+    req->next = NULL;
+
+    pthread_mutex_lock(&s->lock);
+    if (s->stopping) {
+        pthread_mutex_unlock(&s->lock);
+        req->status = NTT_SERVICE_ESTOPPED;
+        return req->status;
+    }
+    req->submit_ns = now_ns();
+    int m = req->mode;
+    if (s->tail[m])
+        s->tail[m]->next = req;
+    else
+        s->head[m] = req;
+    s->tail[m] = req;
+    s->queued[m]++;
+    s->stats.requests++;
+    // a new head starts a window, a full queue or window 0 is ready now;
+    // anything else is already covered by a worker's timed wait
+    if (s->queued[m] == 1 || s->queued[m] >= s->config.max_batch || s->config.window_us == 0)
+        pthread_cond_signal(&s->work);
+    pthread_mutex_unlock(&s->lock);
+    return NTT_SERVICE_OK;
+}
+
+int ntt_request_wait(ntt_service *s, ntt_request *req) {
+    pthread_mutex_lock(&s->lock);
+    while (!req->completed) pthread_cond_wait(&s->done, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+    return req->status;
+}
+
+int ntt_service_call(ntt_service *s, uint16_t *coeffs, int mode) {
+    ntt_request req = {0};
+    req.coeffs = coeffs;
+    req.mode = mode;
+    int status = ntt_service_submit(s, &req);
+    if (status != NTT_SERVICE_OK) return status;
+    return ntt_request_wait(s, &req);
+}
+
+void ntt_service_get_stats(ntt_service *s, ntt_service_stats *stats) {
+    pthread_mutex_lock(&s->lock);
+    *stats = s->stats;
+    pthread_mutex_unlock(&s->lock);
+}
+
+// -----------------------------------------------------------------------------
+// Unix socket front end
+// One reader thread per connection turns messages into requests; the completion
+// callback writes the response, so a connection keeps any number in flight.
+// -----------------------------------------------------------------------------
+struct ntt_connection {
+    ntt_service *service;
+    int fd;
+    pthread_t reader;
+    pthread_mutex_t lock;       //serializes responses, guards in_flight
+    pthread_cond_t idle;
+    int in_flight;
+    int finished;               //reader has returned, the slot can be reused
+};
+
+typedef struct {
+    ntt_request req;
+    ntt_connection *conn;
+    ntt_wire_response resp;     //coeffs are transformed in place here
+} conn_request;
+
+static int read_full(int fd, void *buf, size_t len) {
+    uint8_t *p = buf;
+    while (len) {
+        ssize_t r = read(fd, p, len);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        p += r;
+        len -= (size_t)r;
+    }
+    return 0;
+}
+
+static int write_full(int fd, const void *buf, size_t len) {
+    const uint8_t *p = buf;
+    while (len) {
+        ssize_t r = send(fd, p, len, MSG_NOSIGNAL);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        p += r;
+        len -= (size_t)r;
+    }
+    return 0;
+}
+
+static void conn_respond(ntt_connection *c, conn_request *cr) {
+    pthread_mutex_lock(&c->lock);
+    write_full(c->fd, &cr->resp, sizeof(cr->resp));    //a failed write ends with the reader
+    if (--c->in_flight == 0) pthread_cond_broadcast(&c->idle);
+    pthread_mutex_unlock(&c->lock);
+    free(cr);
+}
+
+static void conn_done(ntt_request *req, void *arg) {
+    conn_request *cr = arg;
+    cr->resp.status = req->status;
+    conn_respond(cr->conn, cr);
+}
+
+static void *conn_main(void *arg) {
+    ntt_connection *c = arg;
+    ntt_wire_request msg;
+
+    while (read_full(c->fd, &msg, sizeof(msg)) == 0) {
+        conn_request *cr = malloc(sizeof(*cr));
+        if (!cr) break;
+        cr->conn = c;
+        cr->resp.id = msg.id;
+        memcpy(cr->resp.coeffs, msg.coeffs, sizeof(cr->resp.coeffs));
+        memset(&cr->req, 0, sizeof(cr->req));
+        cr->req.coeffs = cr->resp.coeffs;
+        cr->req.mode = msg.mode;
+        cr->req.done = conn_done;
+        cr->req.done_arg = cr;
+
+        pthread_mutex_lock(&c->lock);
+        c->in_flight++;
+        pthread_mutex_unlock(&c->lock);
+
+        int status = ntt_service_submit(c->service, &cr->req);
+        if (status != NTT_SERVICE_OK) {
+            cr->resp.status = status;
+            conn_respond(c, cr);
+        }
+    }
+
+    // responses of queued requests still need the socket
+    pthread_mutex_lock(&c->lock);
+    while (c->in_flight) pthread_cond_wait(&c->idle, &c->lock);
+    c->finished = 1;
+    pthread_mutex_unlock(&c->lock);
+    return NULL;
+}
+
+static void conn_free(ntt_connection *c) {
+    close(c->fd);
+    pthread_cond_destroy(&c->idle);
+    pthread_mutex_destroy(&c->lock);
+    free(c);
+}
+
+static int conn_finished(ntt_connection *c) {
+    pthread_mutex_lock(&c->lock);
+    int finished = c->finished;
+    pthread_mutex_unlock(&c->lock);
+    return finished;
+}
+
+static void *acceptor_main(void *arg) {
+    ntt_service *s = arg;
+
+    for (;;) {
+        int fd = accept(s->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;  //listening socket shut down
+        }
+
+        ntt_connection *c = calloc(1, sizeof(*c));
+        if (!c) {
+            close(fd);
+            continue;
+        }
+        c->service = s;
+        c->fd = fd;
+        pthread_mutex_init(&c->lock, NULL);
+        pthread_cond_init(&c->idle, NULL);
+
+        // the table is only touched here and by stop_listening after this thread ends
+        int slot = -1;
+        for (int i = 0; i < s->connection_count && slot < 0; i++)
+            if (!s->connections[i] || conn_finished(s->connections[i])) slot = i;
+        if (slot < 0 && s->connection_count < NTT_SERVICE_MAX_CONNECTIONS) slot = s->connection_count++;
+        if (slot < 0) {
+            conn_free(c);
+            continue;
+        }
+        if (s->connections[slot]) {
+            pthread_join(s->connections[slot]->reader, NULL);
+            conn_free(s->connections[slot]);
+        }
+        s->connections[slot] = c;
+        if (pthread_create(&c->reader, NULL, conn_main, c) != 0) {
+            s->connections[slot] = NULL;
+            conn_free(c);
+        }
+    }
+    return NULL;
+}
+
+int ntt_service_listen(ntt_service *s, const char *path) {
+    struct sockaddr_un addr;
+
+    if (s->listen_fd >= 0 || strlen(path) >= sizeof(addr.sun_path)) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    unlink(path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    s->listen_fd = fd;
+    s->listen_path = strdup(path);
+    if (pthread_create(&s->acceptor, NULL, acceptor_main, s) != 0) {
+        close(fd);
+        unlink(path);
+        free(s->listen_path);
+        s->listen_path = NULL;
+        s->listen_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+// stops accepting, ends every connection's reader and waits for its responses.
+// the workers are still running, so queued socket requests complete normally.
+static void stop_listening(ntt_service *s) {
+    if (s->listen_fd < 0) return;
+
+    shutdown(s->listen_fd, SHUT_RDWR);
+    pthread_join(s->acceptor, NULL);
+    close(s->listen_fd);
+    unlink(s->listen_path);
+    free(s->listen_path);
+    s->listen_path = NULL;
+    s->listen_fd = -1;
+
+    for (int i = 0; i < s->connection_count; i++) {
+        ntt_connection *c = s->connections[i];
+        if (!c) continue;
+        shutdown(c->fd, SHUT_RD);
+        pthread_join(c->reader, NULL);
+        conn_free(c);
+        s->connections[i] = NULL;
+    }
+    s->connection_count = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Client
+// -----------------------------------------------------------------------------
+int ntt_client_connect(const char *path) {
+    struct sockaddr_un addr;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int ntt_client_send(int fd, uint32_t id, int mode, const uint16_t *coeffs) {
+    ntt_wire_request msg;
+    msg.id = id;
+    msg.mode = (uint16_t)mode;
+    msg.reserved = 0;
+    memcpy(msg.coeffs, coeffs, sizeof(msg.coeffs));
+    return write_full(fd, &msg, sizeof(msg));
+}
+
+int ntt_client_recv(int fd, uint32_t *id, int32_t *status, uint16_t *coeffs) {
+    ntt_wire_response msg;
+    if (read_full(fd, &msg, sizeof(msg)) != 0) return -1;
+    *id = msg.id;
+    *status = msg.status;
+    memcpy(coeffs, msg.coeffs, sizeof(msg.coeffs));
+    return 0;
+}
+
+int ntt_client_call(int fd, uint16_t *coeffs, int mode) {
+    uint32_t id;
+    int32_t status;
+    if (ntt_client_send(fd, 0, mode, coeffs) != 0) return -1;
+    if (ntt_client_recv(fd, &id, &status, coeffs) != 0) return -1;
+    return status;
+}
@@ -0,0 +1,160 @@
+#ifndef NTT_SERVICE_H
+#define NTT_SERVICE_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include "kyber_params.h"
+#include "ntt_batch.h"
+
+// Request-batching front end for the NTT kernels.
+// Callers submit one polynomial at a time; worker threads collect the queued requests
+// of each direction into a batch and run it on the backend with the lowest estimated
+// cost. A batch is dispatched when it holds max_batch requests or when its oldest
+// request has waited window_us, whichever comes first. window_us = 0 dispatches
+// whatever is queued as soon as a worker is free.
+//
+// Results come back through a completion callback or ntt_request_wait.
+// ntt_service_listen exposes the same queue over a Unix stream socket.
+
+#define NTT_SERVICE_MAX_BATCH         256
+#define NTT_SERVICE_MAX_BACKENDS      4
+#define NTT_SERVICE_MAX_WORKERS       8
+#define NTT_SERVICE_MAX_CONNECTIONS   32
+
+#define NTT_SERVICE_DEFAULT_BATCH     64
+#define NTT_SERVICE_DEFAULT_WINDOW_US 50
+
+// request status
+#define NTT_SERVICE_OK        0
+#define NTT_SERVICE_EINVAL   -1     //bad mode, missing coefficients or a coefficient >= Q
+#define NTT_SERVICE_ESTOPPED -2     //service is shutting down
+
+typedef struct ntt_request ntt_request;
+typedef void (*ntt_done_fn)(ntt_request *req, void *arg);
+
+struct ntt_request {
+    uint16_t *coeffs;       //KYBER_POL_LENGTH coefficients in [0, Q), transformed in place
+    int mode;               //NTT_BATCH_FORWARD or NTT_BATCH_INVERSE
+    ntt_done_fn done;       //optional, runs on a worker thread once the result is in coeffs
+    void *done_arg;
+
+    // filled in by the service
+    int status;
+    int completed;          //set for requests without a callback, see ntt_request_wait
+    uint64_t submit_ns;     //CLOCK_MONOTONIC
+    uint64_t complete_ns;
+    const char *backend;    //name of the backend that ran the batch
+    ntt_request *next;
+};
+
+// A backend transforms count polynomials in place. lanes is how many it handles in one
+// pass, the cost model is ns_fixed + ns_per_pass * ceil(count / lanes) + ns_per_poly * count.
+// With ns_per_pass and ns_per_poly both 0 they are fitted when the service starts, from
+// timing one polynomial and one full pass.
+// A board build registers the FPGA path here with run = a wrapper around NttPool_Submit
+// and NttPool_Wait (lanes = NTT_POOL_MAX_POLYS, ns_fixed = interrupt latency,
+// ns_per_poly = the 1 KiB copy in and out).
+typedef struct {
+    const char *name;
+    int lanes;
+    void (*run)(void *ctx, uint16_t *const *polys, int count, int mode);
+    void *ctx;
+    double ns_fixed;
+    double ns_per_pass;
+    double ns_per_poly;
+} ntt_backend;
+
+typedef struct {
+    int max_batch;          //1..NTT_SERVICE_MAX_BATCH
+    int window_us;
+    int workers;            //1..NTT_SERVICE_MAX_WORKERS
+} ntt_service_config;
+
+typedef struct {
+    uint64_t requests;
+    uint64_t batches;
+    uint64_t size_flushes;      //batches dispatched because max_batch requests were queued
+    uint64_t deadline_flushes;  //batches dispatched by the window or at shutdown
+    uint64_t backend_batches[NTT_SERVICE_MAX_BACKENDS];
+    uint64_t backend_polys[NTT_SERVICE_MAX_BACKENDS];
+} ntt_service_stats;
+
+typedef struct ntt_connection ntt_connection;
+
+typedef struct {
+    ntt_service_config config;
+    ntt_backend backends[NTT_SERVICE_MAX_BACKENDS];
+    int backend_count;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work;        //queue changed
+    pthread_cond_t done;        //a batch without callbacks completed
+    ntt_request *head[2], *tail[2];     //pending requests per mode, oldest first
+    int queued[2];
+    int running;
+    int stopping;
+    pthread_t workers[NTT_SERVICE_MAX_WORKERS];
+    ntt_service_stats stats;
+
+    // Unix socket front end
+    int listen_fd;
+    char *listen_path;
+    pthread_t acceptor;
+    ntt_connection *connections[NTT_SERVICE_MAX_CONNECTIONS];
+    int connection_count;
+} ntt_service;
+
+// config NULL: NTT_SERVICE_DEFAULT_BATCH, NTT_SERVICE_DEFAULT_WINDOW_US, one worker.
+// registers the built-in backends: "scalar" (ntt_batch_ref) and, in AVX2 builds,
+// "avx2" (ntt_batch).
+// returns -1 on a bad config.
+int ntt_service_init(ntt_service *s, const ntt_service_config *config);
+// before ntt_service_start only. returns -1 when the table is full.
+int ntt_service_add_backend(ntt_service *s, const ntt_backend *backend);
+// calibrates the backends and starts the workers. ntt_service_destroy is needed
+// after a failed start too.
+int ntt_service_start(ntt_service *s);
+// closes the socket front end, runs every queued request, then joins the workers
+void ntt_service_destroy(ntt_service *s);
+
+// queues req and returns at once. returns the request status, the callback is not
+// called for a request that is rejected here.
+int ntt_service_submit(ntt_service *s, ntt_request *req);
+// blocks until a request submitted without a callback is complete, returns its status.
+// with a callback the service does not touch the request after calling it.
+int ntt_request_wait(ntt_service *s, ntt_request *req);
+// submit + wait
+int ntt_service_call(ntt_service *s, uint16_t *coeffs, int mode);
+
+void ntt_service_get_stats(ntt_service *s, ntt_service_stats *stats);
+
+// -----------------------------------------------------------------------------
+// Unix socket front end
+// Fixed-size messages in host byte order (the socket is local to the machine).
+// A client may pipeline any number of requests on one connection; responses come
+// back in completion order and are matched by id.
+// -----------------------------------------------------------------------------
+typedef struct {
+    uint32_t id;
+    uint16_t mode;
+    uint16_t reserved;
+    uint16_t coeffs[KYBER_POL_LENGTH];
+} ntt_wire_request;
+
+typedef struct {
+    uint32_t id;
+    int32_t status;
+    uint16_t coeffs[KYBER_POL_LENGTH];
+} ntt_wire_response;
+
+// binds path (an existing socket file is replaced) and starts accepting connections
+int ntt_service_listen(ntt_service *s, const char *path);
+
+// client side, blocking. connect returns the socket or -1.
+int ntt_client_connect(const char *path);
+int ntt_client_send(int fd, uint32_t id, int mode, const uint16_t *coeffs);
+int ntt_client_recv(int fd, uint32_t *id, int32_t *status, uint16_t *coeffs);
+// one request, one response
+int ntt_client_call(int fd, uint16_t *coeffs, int mode);
+
+#endif
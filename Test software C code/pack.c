@@ -0,0 +1,287 @@
+#include "pack.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+int compress_width_supported(int d) {
+    return d == 1 || d == 4 || d == 5 || d == 10 || d == 11;
+}
+
+// compress_d(x) = round(2^d * x / Q) mod 2^d
+// the numerator (x << d) + Q/2 stays below 2^23, so the multiply-shift is exact
+uint16_t compress_d(uint16_t x, int d) {
+    uint32_t n = ((uint32_t)x << d) + Q / 2;
+    return (uint16_t)(((uint64_t)n * COMPRESS_MUL) >> COMPRESS_SHIFT) & ((1 << d) - 1);
+}
+
+// decompress_d(y) = round(Q * y / 2^d)
+uint16_t decompress_d(uint16_t y, int d) {
+    return (uint16_t)(((uint32_t)y * Q + (1 << (d - 1))) >> d);
+}
+
+// -----------------------------------------------------------------------------
+// Scalar reference: one bit at a time, little-endian bit order
+// (value i occupies bits [i*d, (i+1)*d) of the byte string)
+// -----------------------------------------------------------------------------
+static void pack_bits_ref(uint8_t *r, const uint16_t *v, int d) {
+    memset(r, 0, KYBER_POLYCOMPRESSEDBYTES(d));
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) {
+        for (int b = 0; b < d; b++) {
+            int pos = i * d + b;
+            if ((v[i] >> b) & 1)
+                r[pos / 8] |= (uint8_t)(1 << (pos % 8));
+        }
+    }
+}
+
+static void unpack_bits_ref(uint16_t *v, const uint8_t *a, int d) {
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) {
+        v[i] = 0;
+        for (int b = 0; b < d; b++) {
+            int pos = i * d + b;
+            v[i] |= (uint16_t)(((a[pos / 8] >> (pos % 8)) & 1) << b);
+        }
+    }
+}
+
+void poly_tobytes_ref(uint8_t *r, const uint16_t *a) {
+    pack_bits_ref(r, a, 12);
+}
+
+void poly_frombytes_ref(uint16_t *r, const uint8_t *a) {
+    unpack_bits_ref(r, a, 12);
+}
+
+int poly_compress_ref(uint8_t *r, const uint16_t *a, int d) {
+    uint16_t t[KYBER_POL_LENGTH];
+
+    if (!compress_width_supported(d)) return -1;
+
+    for (int i = 0; i < KYBER_POL_LENGTH; i++)
+        t[i] = (uint16_t)((((uint32_t)a[i] << d) + Q / 2) / Q) & ((1 << d) - 1);
+
+    pack_bits_ref(r, t, d);
+    return 0;
+}
+
+int poly_decompress_ref(uint16_t *r, const uint8_t *a, int d) {
+    if (!compress_width_supported(d)) return -1;
+
+    unpack_bits_ref(r, a, d);
+    for (int i = 0; i < KYBER_POL_LENGTH; i++)
+        r[i] = (uint16_t)(((uint32_t)r[i] * Q + (1 << (d - 1))) >> d);
+    return 0;
+}
+
+#if defined(__AVX2__)
+// -----------------------------------------------------------------------------
+// AVX2 kernels: 16 coefficients per iteration
+// -----------------------------------------------------------------------------
+
+// packs 16 d-bit values (16-bit lanes) into 2*d bytes.
+// neighbouring values are merged with madd (1, 2^d), then 64-bit and 128-bit
+// shifts fold every half into one contiguous 8*d-bit field.
+// full 16-byte stores are used while 'room' (bytes left in the output) allows it;
+// the bytes they write past r + 2*d are overwritten by the next block.
+static inline void pack16_avx2(uint8_t *r, __m256i v, int d, int room) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m128i half[2];
+
+    __m256i t = _mm256_madd_epi16(v, _mm256_set1_epi32((1 << (16 + d)) | 1));
+    __m256i lo = _mm256_and_si256(t, _mm256_set1_epi64x(0xffffffff));
+    __m256i hi = _mm256_srli_epi64(t, 32);
+    t = _mm256_or_si256(lo, _mm256_sll_epi64(hi, _mm_cvtsi32_si128(2 * d)));
+
+    __m256i h = _mm256_unpackhi_epi64(t, zero);
+    lo = _mm256_or_si256(t, _mm256_sll_epi64(h, _mm_cvtsi32_si128(4 * d)));
+    hi = _mm256_srl_epi64(h, _mm_cvtsi32_si128(64 - 4 * d));
+    t = _mm256_unpacklo_epi64(lo, hi);
+
+    if (room >= d + 16) {
+        _mm_storeu_si128((__m128i *)r, _mm256_castsi256_si128(t));
+        _mm_storeu_si128((__m128i *)(r + d), _mm256_extracti128_si256(t, 1));
+        return;
+    }
+
+    _mm_storeu_si128(&half[0], _mm256_castsi256_si128(t));
+    _mm_storeu_si128(&half[1], _mm256_extracti128_si256(t, 1));
+    memcpy(r, &half[0], d);
+    memcpy(r + d, &half[1], d);
+}
+
+// shuffle pattern moving the 4 bytes that hold value k into 32-bit lane k
+static inline __m256i unpack_shuffle(int d) {
+    uint8_t idx[32];
+    for (int k = 0; k < 8; k++)
+        for (int j = 0; j < 4; j++)
+            idx[4 * k + j] = (uint8_t)((d * k) / 8 + j);
+    return _mm256_loadu_si256((const __m256i *)idx);
+}
+
+static inline __m256i unpack_shift(int d) {
+    return _mm256_setr_epi32(0, d % 8, (2 * d) % 8, (3 * d) % 8,
+                             (4 * d) % 8, (5 * d) % 8, (6 * d) % 8, (7 * d) % 8);
+}
+
+// unpacks 8 d-bit values from d bytes into 32-bit lanes.
+// the 16-byte load may only run past the d bytes while still inside the input (tail == 0)
+static inline __m256i unpack8_avx2(const uint8_t *a, int d, int tail, __m256i shuf, __m256i shift) {
+    __m128i raw;
+
+    if (tail) {
+        uint8_t buf[16] = {0};
+        memcpy(buf, a, d);
+        raw = _mm_loadu_si128((const __m128i *)buf);
+    } else {
+        raw = _mm_loadu_si128((const __m128i *)a);
+    }
+
+    __m256i x = _mm256_broadcastsi128_si256(raw);
+    x = _mm256_shuffle_epi8(x, shuf);
+    x = _mm256_srlv_epi32(x, shift);
+    return _mm256_and_si256(x, _mm256_set1_epi32((1 << d) - 1));
+}
+
+// stores 8 32-bit lanes as uint16_t
+static inline void store8_u16(uint16_t *r, __m256i x) {
+    x = _mm256_permute4x64_epi64(_mm256_packus_epi32(x, x), 0x08);
+    _mm_storeu_si128((__m128i *)r, _mm256_castsi256_si128(x));
+}
+
+// floor(n / Q) for 8 32-bit lanes, n < 2^23
+static inline __m256i divq_avx2(__m256i n) {
+    const __m256i m = _mm256_set1_epi32(COMPRESS_MUL);
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(n, m), COMPRESS_SHIFT);
+    __m256i odd  = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(n, 32), m), COMPRESS_SHIFT);
+    return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+}
+
+static inline __m256i compress8_avx2(__m128i x, int d) {
+    __m256i n = _mm256_cvtepu16_epi32(x);
+    n = _mm256_add_epi32(_mm256_sll_epi32(n, _mm_cvtsi32_si128(d)), _mm256_set1_epi32(Q / 2));
+    return _mm256_and_si256(divq_avx2(n), _mm256_set1_epi32((1 << d) - 1));
+}
+
+static void poly_tobytes_avx2(uint8_t *r, const uint16_t *a) {
+    for (int i = 0; i < KYBER_POL_LENGTH; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&a[i]);
+        int off = (i / 16) * 24;
+        pack16_avx2(r + off, v, 12, KYBER_POLYBYTES - off);
+    }
+}
+
+static void poly_frombytes_avx2(uint16_t *r, const uint8_t *a) {
+    const __m256i shuf = unpack_shuffle(12);
+    const __m256i shift = unpack_shift(12);
+
+    for (int i = 0; i < KYBER_POL_LENGTH; i += 8) {
+        int off = (i / 8) * 12;
+        store8_u16(&r[i], unpack8_avx2(a + off, 12, off + 16 > KYBER_POLYBYTES, shuf, shift));
+    }
+}
+
+static void poly_compress_avx2(uint8_t *r, const uint16_t *a, int d) {
+    for (int i = 0; i < KYBER_POL_LENGTH; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)&a[i]);
+        __m256i lo = compress8_avx2(_mm256_castsi256_si128(x), d);
+        __m256i hi = compress8_avx2(_mm256_extracti128_si256(x, 1), d);
+        __m256i v = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+        int off = (i / 16) * 2 * d;
+        pack16_avx2(r + off, v, d, KYBER_POLYCOMPRESSEDBYTES(d) - off);
+    }
+}
+
+static void poly_decompress_avx2(uint16_t *r, const uint8_t *a, int d) {
+    const __m256i shuf = unpack_shuffle(d);
+    const __m256i shift = unpack_shift(d);
+    const __m256i q = _mm256_set1_epi32(Q);
+    const __m256i half = _mm256_set1_epi32(1 << (d - 1));
+    const __m128i cnt = _mm_cvtsi32_si128(d);
+
+    for (int i = 0; i < KYBER_POL_LENGTH; i += 8) {
+        int off = (i / 8) * d;
+        __m256i y = unpack8_avx2(a + off, d, off + 16 > KYBER_POLYCOMPRESSEDBYTES(d), shuf, shift);
+        y = _mm256_srl_epi32(_mm256_add_epi32(_mm256_mullo_epi32(y, q), half), cnt);
+        store8_u16(&r[i], y);
+    }
+}
+
+#else
+// -----------------------------------------------------------------------------
+// Portable fallback: byte-wise bit accumulator
+// -----------------------------------------------------------------------------
+static void pack_bits(uint8_t *r, const uint16_t *v, int d) {
+    uint32_t acc = 0;
+    int bits = 0;
+
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) {
+        acc |= (uint32_t)v[i] << bits;
+        bits += d;
+        while (bits >= 8) {
+            *r++ = (uint8_t)acc;
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+}
+
+static void unpack_bits(uint16_t *v, const uint8_t *a, int d) {
+    uint32_t acc = 0;
+    int bits = 0;
+
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) {
+        while (bits < d) {
+            acc |= (uint32_t)(*a++) << bits;
+            bits += 8;
+        }
+        v[i] = (uint16_t)(acc & ((1u << d) - 1));
+        acc >>= d;
+        bits -= d;
+    }
+}
+#endif
+
+void poly_tobytes(uint8_t *r, const uint16_t *a) {
+#if defined(__AVX2__)
+    poly_tobytes_avx2(r, a);
+#else
+    pack_bits(r, a, 12);
+#endif
+}
+
+void poly_frombytes(uint16_t *r, const uint8_t *a) {
+#if defined(__AVX2__)
+    poly_frombytes_avx2(r, a);
+#else
+    unpack_bits(r, a, 12);
+#endif
+}
+
+int poly_compress(uint8_t *r, const uint16_t *a, int d) {
+    if (!compress_width_supported(d)) return -1;
+
+#if defined(__AVX2__)
+    poly_compress_avx2(r, a, d);
+#else
+    uint16_t t[KYBER_POL_LENGTH];
+    for (int i = 0; i < KYBER_POL_LENGTH; i++)
+        t[i] = compress_d(a[i], d);
+    pack_bits(r, t, d);
+#endif
+    return 0;
+}
+
+int poly_decompress(uint16_t *r, const uint8_t *a, int d) {
+    if (!compress_width_supported(d)) return -1;
+
+#if defined(__AVX2__)
+    poly_decompress_avx2(r, a, d);
+#else
+    unpack_bits(r, a, d);
+    for (int i = 0; i < KYBER_POL_LENGTH; i++)
+        r[i] = decompress_d(r[i], d);
+#endif
+    return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <stdint.h>
+#include "kyber_params.h"
+
+#define KYBER_POLYBYTES 384 //256 coefficients * 12 bits
+#define KYBER_POLYCOMPRESSEDBYTES(d) ((KYBER_POL_LENGTH * (d)) / 8)
+
+// multiply-shift constant for exact division by Q of any numerator below 2^23:
+// floor(n / Q) == (n * COMPRESS_MUL) >> COMPRESS_SHIFT
+#define COMPRESS_MUL   10321340 //ceil(2^35 / Q)
+#define COMPRESS_SHIFT 35
+
+// returns 1 if d is a compression width used by kyber (1, 4, 5, 10, 11)
+int compress_width_supported(int d);
+
+uint16_t compress_d(uint16_t x, int d);
+uint16_t decompress_d(uint16_t y, int d);
+
+// byte encodings of a whole polynomial. coefficients are expected in [0, Q).
+// the SIMD kernels are used when the build enables AVX2, the scalar code otherwise.
+void poly_tobytes(uint8_t *r, const uint16_t *a);
+void poly_frombytes(uint16_t *r, const uint8_t *a);
+int poly_compress(uint8_t *r, const uint16_t *a, int d);
+int poly_decompress(uint16_t *r, const uint8_t *a, int d);
+
+// scalar references (plain bit loops, '/' for rounding) used to cross-check the fast kernels
+void poly_tobytes_ref(uint8_t *r, const uint16_t *a);
+void poly_frombytes_ref(uint16_t *r, const uint8_t *a);
+int poly_compress_ref(uint8_t *r, const uint16_t *a, int d);
+int poly_decompress_ref(uint16_t *r, const uint8_t *a, int d);
+
+#endif
@@ -0,0 +1,138 @@
+#include "poly_arena.h"
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+static size_t round_up(size_t x, size_t align) {
+    return (x + align - 1) & ~(align - 1);
+}
+
+// -----------------------------------------------------------------------------
+// Arena setup: one anonymous mapping, pre-faulted so requests never page-fault
+// -----------------------------------------------------------------------------
+int poly_arena_init(poly_arena *arena, size_t size, int flags) {
+    void *p = MAP_FAILED;
+
+    memset(arena, 0, sizeof(*arena));
+    if (size == 0) return -1;
+    size = round_up(size, POLY_ARENA_ALIGN);
+
+    if (flags & POLY_ARENA_HUGEPAGES) {
+#ifdef MAP_HUGETLB
+        // needs reserved pages (vm.nr_hugepages), otherwise fall through
+        size_t huge_size = round_up(size, HUGE_PAGE_SIZE);
+        p = mmap(NULL, huge_size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            size = huge_size;
+            arena->backing = POLY_ARENA_BACKING_HUGETLB;
+        }
+#endif
+    }
+
+    if (p == MAP_FAILED) {
+        p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return -1;
+#ifdef MADV_HUGEPAGE
+        if ((flags & POLY_ARENA_HUGEPAGES) && madvise(p, size, MADV_HUGEPAGE) == 0)
+            arena->backing = POLY_ARENA_BACKING_THP;
+#endif
+    }
+
+    // touch every page now instead of on the first request
+    memset(p, 0, size);
+
+    arena->base = p;
+    arena->size = size;
+    return 0;
+}
+
+void poly_arena_destroy(poly_arena *arena) {
+    if (arena->base) munmap(arena->base, arena->size);
+    memset(arena, 0, sizeof(*arena));
+}
+
+// -----------------------------------------------------------------------------
+// Bump allocation
+// -----------------------------------------------------------------------------
+void *poly_arena_alloc(poly_arena *arena, size_t bytes) {
+    size_t start = round_up(arena->used, POLY_ARENA_ALIGN);
+
+    if (!arena->base || start > arena->size || bytes > arena->size - start) {
+        arena->failures++;
+        return NULL;
+    }
+
+    arena->used = start + bytes;
+    if (arena->used > arena->high_water) arena->high_water = arena->used;
+    arena->allocs++;
+    return arena->base + start;
+}
+
+void poly_arena_reset(poly_arena *arena) {
+    arena->used = 0;
+    arena->resets++;
+}
+
+// -----------------------------------------------------------------------------
+// Per-thread arena
+// -----------------------------------------------------------------------------
+// The mapping is released by a pthread key destructor when the thread exits. The
+// key's value is only used to get the destructor called; it points at the thread's
+// own arena. Key destructors do not run for the main thread returning from main,
+// the process exit unmaps it there.
+static _Thread_local poly_arena thread_arena;
+static pthread_key_t thread_arena_key;
+static pthread_once_t thread_arena_once = PTHREAD_ONCE_INIT;
+
+static void thread_arena_release(void *arena) {
+    poly_arena_destroy(arena);
+}
+
+static void thread_arena_key_init(void) {
+    pthread_key_create(&thread_arena_key, thread_arena_release);
+}
+
+static int thread_arena_create(size_t size, int flags) {
+    if (poly_arena_init(&thread_arena, size, flags) != 0) return -1;
+    pthread_once(&thread_arena_once, thread_arena_key_init);
+    pthread_setspecific(thread_arena_key, &thread_arena);
+    return 0;
+}
+
+int poly_arena_thread_init(size_t size, int flags) {
+    if (thread_arena.base) poly_arena_destroy(&thread_arena);
+    return thread_arena_create(size, flags);
+}
+
+poly_arena *poly_arena_thread(void) {
+    if (!thread_arena.base && thread_arena_create(POLY_ARENA_DEFAULT_SIZE, 0) != 0)
+        return NULL;
+    return &thread_arena;
+}
+
+// -----------------------------------------------------------------------------
+// Containers
+// -----------------------------------------------------------------------------
+poly *poly_alloc(poly_arena *arena) {
+    return poly_arena_alloc(arena, sizeof(poly));
+}
+
+int polyvec_alloc(polyvec *v, poly_arena *arena, int k) {
+    if (k <= 0) return -1;
+    v->vec = poly_arena_alloc(arena, (size_t)k * sizeof(poly));
+    if (!v->vec) return -1;
+    v->k = k;
+    return 0;
+}
+
+int polymat_alloc(polymat *m, poly_arena *arena, int k, int l) {
+    if (k <= 0 || l <= 0) return -1;
+    m->rows = poly_arena_alloc(arena, (size_t)k * l * sizeof(poly));
+    if (!m->rows) return -1;
+    m->k = k;
+    m->l = l;
+    return 0;
+}
@@ -0,0 +1,86 @@
+#ifndef POLY_ARENA_H
+#define POLY_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "kyber_params.h"
+
+#define POLY_ARENA_ALIGN        64                  //cache line, also the widest SIMD load
+#define POLY_ARENA_DEFAULT_SIZE (256 * 1024)        //fits a 4x4 matrix + vectors with room to spare
+
+// poly_arena_init flags
+#define POLY_ARENA_HUGEPAGES    1                   //try MAP_HUGETLB, fall back to transparent huge pages
+
+// how the arena memory ended up being backed
+#define POLY_ARENA_BACKING_PAGES   0
+#define POLY_ARENA_BACKING_HUGETLB 1
+#define POLY_ARENA_BACKING_THP     2
+
+// one polynomial = 256 coefficients = 512 bytes = 8 cache lines.
+// vectors and matrices are contiguous arrays of these, so a k-vector is also a
+// plain uint16_t[k * KYBER_POL_LENGTH] for the batch and SIMD kernels.
+typedef struct {
+    uint16_t coeffs[KYBER_POL_LENGTH];
+} __attribute__((aligned(POLY_ARENA_ALIGN))) poly;
+
+typedef struct {
+    poly *vec;
+    int k;
+} polyvec;
+
+// row-major: element (i, j) is rows[i * cols + j], row i is a polyvec of length cols
+typedef struct {
+    poly *rows;
+    int k;      //rows
+    int l;      //columns
+} polymat;
+
+// bump allocator over one mapping, memory is handed back all at once with poly_arena_reset
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    int backing;
+
+    // statistics
+    uint64_t allocs;        //successful allocations since init
+    uint64_t failures;      //allocations that did not fit
+    uint64_t resets;
+    size_t high_water;      //largest 'used' seen
+} poly_arena;
+
+int poly_arena_init(poly_arena *arena, size_t size, int flags);
+void poly_arena_destroy(poly_arena *arena);
+
+// returns POLY_ARENA_ALIGN aligned memory or NULL when the arena is full
+void *poly_arena_alloc(poly_arena *arena, size_t bytes);
+// releases every allocation at once (end of a request)
+void poly_arena_reset(poly_arena *arena);
+
+// arena of the calling thread, created on first use with POLY_ARENA_DEFAULT_SIZE and
+// unmapped when the thread exits. call poly_arena_thread_init first to pick another
+// size or huge pages.
+int poly_arena_thread_init(size_t size, int flags);
+poly_arena *poly_arena_thread(void);
+
+// containers, uninitialised like poly_arena_alloc (clear with polyvec_zero where a
+// kernel accumulates). return NULL / -1 when the arena is full.
+poly *poly_alloc(poly_arena *arena);
+int polyvec_alloc(polyvec *v, poly_arena *arena, int k);
+int polymat_alloc(polymat *m, poly_arena *arena, int k, int l);
+
+static inline poly *polymat_at(const polymat *m, int i, int j) {
+    return &m->rows[i * m->l + j];
+}
+
+static inline polyvec polymat_row(const polymat *m, int i) {
+    polyvec row = { &m->rows[i * m->l], m->l };
+    return row;
+}
+
+static inline void polyvec_zero(polyvec *v) {
+    memset(v->vec, 0, (size_t)v->k * sizeof(poly));
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "poly_ntt.h"
+#include "ntt.h"
+#include "kyber_consts.h"
+
+#define N 256
+
+#if KYBER_Q != Q || KYBER_N != N || KYBER_MONT_R_BITS != 16
+#error "kyber_consts.h does not match kyber_params.h"
+#endif
+
+// kyber_zetas[m][i] = omega^bitrev7(i) as in ntt_standard, m = 0 forward, 1 inverse,
+// generated at build time (gen_tables).
+
+// -----------------------------------------------------------------------------
+// Scalar reference
+// -----------------------------------------------------------------------------
+// x / 2 mod Q for x in [0, Q)
+static inline uint16_t half_mod(uint16_t x) {
+    return (uint16_t)((x + ((x & 1) ? Q : 0)) >> 1);
+}
+
+void poly_ntt_ref(uint16_t *a) {
+    const uint16_t *zetas = kyber_zetas[0];
+    for (int len = N / 2; len >= 1; len >>= 1) {
+        int step = N / (2 * len);
+        for (int start = 0; start < N; start += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                int pos = start + j;
+                uint16_t u = a[pos];
+                uint16_t v = mod_mul(a[pos + len], zetas[j * step]);
+                a[pos] = mod_add(u, v);
+                a[pos + len] = mod_sub(u, v);
+            }
+        }
+    }
+}
+
+void poly_invntt_ref(uint16_t *a) {
+    const uint16_t *zetas = kyber_zetas[1];
+    for (int len = 1; len < N; len <<= 1) {
+        int step = N / (2 * len);
+        for (int start = 0; start < N; start += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                int pos = start + j;
+                uint16_t u = a[pos];
+                uint16_t v = a[pos + len];
+                a[pos] = half_mod(mod_add(u, v));
+                a[pos + len] = half_mod(mod_mul(mod_sub(u, v), zetas[j * step]));
+            }
+        }
+    }
+}
+
+void poly_basemul_ref(uint16_t *r, const uint16_t *a, const uint16_t *b) {
+    for (int i = 0; i < N; i++) r[i] = mod_mul(a[i], b[i]);
+}
+
+void poly_reduce_ref(uint16_t *a) {
+    for (int i = 0; i < N; i++) a[i] = a[i] % Q;
+}
+
+// -----------------------------------------------------------------------------
+// Kernels: the generated straight-line transforms, scalar basemul and reduction
+// -----------------------------------------------------------------------------
+void poly_ntt(uint16_t *a) {
+    kyber_ntt_unrolled(a);
+}
+
+void poly_invntt(uint16_t *a) {
+    kyber_intt_unrolled(a);
+}
+
+void poly_basemul(uint16_t *r, const uint16_t *a, const uint16_t *b) {
+    poly_basemul_ref(r, a, b);
+}
+
+void poly_reduce(uint16_t *a) {
+    poly_reduce_ref(a);
+}
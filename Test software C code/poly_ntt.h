@@ -0,0 +1,27 @@
+#ifndef POLY_NTT_H
+#define POLY_NTT_H
+
+#include <stdint.h>
+#include "kyber_params.h"
+
+// Single-polynomial kernels for the processor side, n = KYBER_POL_LENGTH, in place.
+// The transforms match the hardware and ntt_standard/intt_standard: forward with
+// omega = 910, inverse with omega = 3040 and a halving after every stage.
+// Coefficients are expected in [0, Q) and stay there.
+//
+// The transforms are the generated kyber_ntt_unrolled/kyber_intt_unrolled, basemul and
+// reduce the scalar code.
+void poly_ntt(uint16_t *a);
+void poly_invntt(uint16_t *a);
+// r = a * b mod Q coefficient-wise (product in the NTT domain). r may alias a or b.
+void poly_basemul(uint16_t *r, const uint16_t *a, const uint16_t *b);
+// any 16-bit value to [0, Q), e.g. after lazy additions
+void poly_reduce(uint16_t *a);
+
+// scalar references, no tracing output
+void poly_ntt_ref(uint16_t *a);
+void poly_invntt_ref(uint16_t *a);
+void poly_basemul_ref(uint16_t *r, const uint16_t *a, const uint16_t *b);
+void poly_reduce_ref(uint16_t *a);
+
+#endif
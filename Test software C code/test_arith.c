@@ -0,0 +1,377 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "barrett.h"
+#include "booth.h"
+#include "montgomery.h"
+#include "poly_ntt.h"
+#include "kyber_params.h"
+
+// Differential verifier for the multipliers and reductions: barrett_reduce,
+// montgomery_reduce (alone and as a to/reduce/from multiplication), booth_multiply and
+// the poly_basemul/poly_reduce kernels, against plain % Q and a * b.
+// Every check walks an index space that is either the whole operand domain (exhaustive)
+// or a sample of it (index -> operands through a fixed hash, reproducible for any thread
+// count). The space is split into chunks handed out to worker threads; inside a chunk
+// operands, expected and actual results go through BLOCK-sized arrays so the reference
+// and the comparison loops vectorize.
+//
+// Then the lazy-reduction bounds: how far above the domain it needs each reducer stays
+// correct (montgomery_reduce: the first failing T above Q * R), and how many unreduced
+// products or additions of canonical values fit into it.
+//
+// Quiet by default, one line per check at the end. Exit status 1 on any mismatch.
+// Every check is exhaustive by default, barrett_reduce's and booth_multiply's 2^32 spaces
+// included. The index space is handed out to the worker threads in CHUNK-sized ranges (one
+// first operand each for booth_multiply over 16-bit operands, the long one at about a
+// CPU-minute), so the run scales with the core count. 'sample' trades that space for
+// SAMPLES random points for a quick run; a sampled check is listed as SAMPLED and the
+// summary says which spaces were not verified, it never counts as a full pass.
+//
+// usage: test_arith [sample] [verbose] [threads]
+//   sample   run SAMPLES random points of booth_multiply over 65536 x 65536 operands
+//            instead of all of them
+//   verbose  print the first mismatches of every check as they are found
+//   threads  worker count, default: online processors
+
+#define BLOCK          256
+#define CHUNK          (1u << 16)      //indices per work item
+#define SAMPLES        (1u << 24)      //random points per sampled check
+#define MAX_REPORTED   4               //mismatches printed per check in verbose mode
+#define PROBE_SPAN     (1u << 24)      //inputs scanned above a bound for the first failure
+
+#if BLOCK != KYBER_POL_LENGTH
+#error "the poly_* checks run one polynomial per block"
+#endif
+
+typedef struct check check;
+
+// runs indices [begin, end), end - begin <= BLOCK, returns the mismatch count
+typedef uint64_t (*check_fn)(check *c, uint64_t begin, uint64_t end);
+
+struct check {
+    const char *name;
+    const char *domain;
+    uint32_t range;         //exhaustive pair checks: operands a, b < range, index a * range + b
+    uint64_t size;          //indices to run
+    double space;           //operand space the indices are drawn from
+    int sampled;
+    check_fn run;
+
+    // filled in by the workers
+    uint64_t mismatches;
+    uint64_t first_bad;     //lowest failing index, UINT64_MAX if none
+    int reported;
+};
+
+static int verbose = 0;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+static void report(check *c, uint64_t index, const char *fmt, uint64_t x, uint64_t y, uint64_t expected, uint64_t got) {
+    pthread_mutex_lock(&lock);
+    if (index < c->first_bad) c->first_bad = index;
+    if (verbose && c->reported < MAX_REPORTED) {
+        printf("%s: ", c->name);
+        printf(fmt, (unsigned long long)x, (unsigned long long)y);
+        printf(": expected %llu, got %llu\n", (unsigned long long)expected, (unsigned long long)got);
+        c->reported++;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+// operands of index i: the exhaustive checks split it into (i / range, i % range), the sampled
+// ones hash it
+static inline uint32_t sample32(uint64_t i, uint32_t salt) {
+    return (uint32_t)splitmix64(i ^ ((uint64_t)salt << 40));
+}
+
+// -----------------------------------------------------------------------------
+// Checks. Each fills x[]/y[] with the operands, want[] with the reference and got[]
+// with the implementation under test, then counts the differences.
+// -----------------------------------------------------------------------------
+static uint64_t count_diff(check *c, uint64_t begin, int n, const uint32_t *x, const uint32_t *y,
+                           const uint32_t *want, const uint32_t *got, const char *fmt) {
+    uint32_t diff = 0;
+    for (int k = 0; k < n; k++) diff |= want[k] ^ got[k];
+    if (!diff) return 0;
+
+    uint64_t bad = 0;
+    for (int k = 0; k < n; k++) {
+        if (want[k] != got[k]) {
+            report(c, begin + k, fmt, x[k], y[k], want[k], got[k]);
+            bad++;
+        }
+    }
+    return bad;
+}
+
+// booth_multiply(a, b) == a * b
+static uint64_t run_booth(check *c, uint64_t begin, uint64_t end) {
+    uint32_t x[BLOCK], y[BLOCK], want[BLOCK], got[BLOCK];
+    int n = (int)(end - begin);
+
+    for (int k = 0; k < n; k++) {
+        uint64_t i = begin + k;
+        if (c->sampled) {
+            uint32_t r = sample32(i, 1);
+            x[k] = r >> 16;
+            y[k] = r & 0xffff;
+        } else {
+            x[k] = (uint32_t)(i / c->range);
+            y[k] = (uint32_t)(i % c->range);
+        }
+    }
+    for (int k = 0; k < n; k++) want[k] = x[k] * y[k];
+    for (int k = 0; k < n; k++) got[k] = booth_multiply((uint16_t)x[k], (uint16_t)y[k]);
+    return count_diff(c, begin, n, x, y, want, got, "%llu * %llu");
+}
+
+// barrett_reduce(x, Q) == x % Q
+static uint64_t run_barrett(check *c, uint64_t begin, uint64_t end) {
+    uint32_t x[BLOCK], y[BLOCK], want[BLOCK], got[BLOCK];
+    int n = (int)(end - begin);
+
+    for (int k = 0; k < n; k++) {
+        x[k] = c->sampled ? sample32(begin + k, 2) : (uint32_t)(begin + k);
+        y[k] = Q;
+    }
+    for (int k = 0; k < n; k++) want[k] = x[k] % Q;
+    for (int k = 0; k < n; k++) got[k] = barrett_reduce(x[k], Q);
+    return count_diff(c, begin, n, x, y, want, got, "%llu mod %llu");
+}
+
+// montgomery_reduce(T) == T * R^-1 mod Q for T < Q * R
+static uint64_t run_montgomery(check *c, uint64_t begin, uint64_t end) {
+    uint32_t x[BLOCK], y[BLOCK], want[BLOCK], got[BLOCK];
+    int n = (int)(end - begin);
+
+    for (int k = 0; k < n; k++) {
+        x[k] = (uint32_t)(begin + k);
+        y[k] = _R;
+    }
+    for (int k = 0; k < n; k++) want[k] = (uint32_t)((uint64_t)(x[k] % Q) * RINV % Q);
+    for (int k = 0; k < n; k++) got[k] = montgomery_reduce(x[k], Q, QINV, _R);
+    return count_diff(c, begin, n, x, y, want, got, "%llu / %llu");
+}
+
+// from_montgomery(montgomery_reduce(to_montgomery(a) * to_montgomery(b))) == a * b mod Q
+static uint64_t run_montgomery_mul(check *c, uint64_t begin, uint64_t end) {
+    uint32_t x[BLOCK], y[BLOCK], want[BLOCK], got[BLOCK];
+    int n = (int)(end - begin);
+
+    for (int k = 0; k < n; k++) {
+        x[k] = (uint32_t)((begin + k) / c->range);
+        y[k] = (uint32_t)((begin + k) % c->range);
+    }
+    for (int k = 0; k < n; k++) want[k] = x[k] * y[k] % Q;
+    for (int k = 0; k < n; k++) {
+        uint32_t T = (uint32_t)to_montgomery((uint16_t)x[k], _R, Q) * to_montgomery((uint16_t)y[k], _R, Q);
+        got[k] = from_montgomery(montgomery_reduce(T, Q, QINV, _R), RINV, Q);
+    }
+    return count_diff(c, begin, n, x, y, want, got, "%llu * %llu");
+}
+
+// poly_basemul over blocks of KYBER_POL_LENGTH operand pairs
+static uint64_t run_basemul(check *c, uint64_t begin, uint64_t end) {
+    uint16_t a[BLOCK], b[BLOCK], r[BLOCK];
+    uint32_t x[BLOCK], y[BLOCK], want[BLOCK], got[BLOCK];
+    int n = (int)(end - begin);
+
+    for (int k = 0; k < BLOCK; k++) {
+        uint64_t i = k < n ? begin + k : begin;
+        x[k] = (uint32_t)(i / c->range);
+        y[k] = (uint32_t)(i % c->range);
+        a[k] = (uint16_t)x[k];
+        b[k] = (uint16_t)y[k];
+    }
+    for (int k = 0; k < BLOCK; k++) want[k] = x[k] * y[k] % Q;
+    poly_basemul(r, a, b);
+    for (int k = 0; k < BLOCK; k++) got[k] = r[k];
+    return count_diff(c, begin, n, x, y, want, got, "%llu * %llu");
+}
+
+// poly_reduce over every 16-bit input
+static uint64_t run_reduce(check *c, uint64_t begin, uint64_t end) {
+    uint16_t a[BLOCK];
+    uint32_t x[BLOCK], y[BLOCK], want[BLOCK], got[BLOCK];
+    int n = (int)(end - begin);
+
+    for (int k = 0; k < BLOCK; k++) {
+        x[k] = (uint32_t)((k < n ? begin + k : begin) & 0xffff);
+        y[k] = Q;
+        a[k] = (uint16_t)x[k];
+    }
+    for (int k = 0; k < BLOCK; k++) want[k] = x[k] % Q;
+    poly_reduce(a);
+    for (int k = 0; k < BLOCK; k++) got[k] = a[k];
+    return count_diff(c, begin, n, x, y, want, got, "%llu mod %llu");
+}
+
+// montgomery_reduce above its domain, index i is T = Q * R + i; used to find the bound
+static uint64_t run_montgomery_probe(check *c, uint64_t begin, uint64_t end) {
+    uint32_t x[BLOCK], y[BLOCK], want[BLOCK], got[BLOCK];
+    int n = (int)(end - begin);
+
+    for (int k = 0; k < n; k++) {
+        x[k] = (uint32_t)((uint64_t)Q * _R + begin + k);
+        y[k] = _R;
+    }
+    for (int k = 0; k < n; k++) want[k] = (uint32_t)((uint64_t)(x[k] % Q) * RINV % Q);
+    for (int k = 0; k < n; k++) got[k] = montgomery_reduce(x[k], Q, QINV, _R);
+    return count_diff(c, begin, n, x, y, want, got, "%llu / %llu");
+}
+
+// -----------------------------------------------------------------------------
+// Work distribution
+// -----------------------------------------------------------------------------
+typedef struct {
+    check *c;
+    uint64_t next;          //next chunk start, under lock
+} work;
+
+static void *worker_main(void *arg) {
+    work *w = arg;
+    check *c = w->c;
+    uint64_t bad = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&lock);
+        uint64_t begin = w->next;
+        w->next = begin < c->size ? begin + CHUNK : begin;
+        pthread_mutex_unlock(&lock);
+        if (begin >= c->size) break;
+
+        uint64_t end = begin + CHUNK < c->size ? begin + CHUNK : c->size;
+        for (uint64_t i = begin; i < end; i += BLOCK)
+            bad += c->run(c, i, i + BLOCK < end ? i + BLOCK : end);
+    }
+
+    pthread_mutex_lock(&lock);
+    c->mismatches += bad;
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+static double now_s(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static double run_check(check *c, int threads) {
+    pthread_t tid[threads];
+    work w = {c, 0};
+    double t0 = now_s();
+
+    c->mismatches = 0;
+    c->first_bad = UINT64_MAX;
+    c->reported = 0;
+    for (int i = 0; i < threads; i++) pthread_create(&tid[i], NULL, worker_main, &w);
+    for (int i = 0; i < threads; i++) pthread_join(tid[i], NULL);
+    return now_s() - t0;
+}
+
+int main(int argc, char **argv) {
+    int sample = 0, threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "sample") == 0)
+            sample = 1;
+        else if (strcmp(argv[i], "verbose") == 0)
+            verbose = 1;
+        else if (atoi(argv[i]) > 0)
+            threads = atoi(argv[i]);
+        else {
+            printf("usage: %s [sample] [verbose] [threads]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+
+    const uint64_t qq = (uint64_t)Q * Q;
+    check checks[] = {
+        {.name = "booth_multiply",    .domain = "a, b < Q",    .range = Q,     .size = qq,
+         .space = qq,             .run = run_booth},
+        {.name = "booth_multiply",    .domain = "a, b < 2^16", .range = 65536, .size = sample ? SAMPLES : 1ull << 32,
+         .space = 4294967296.0,   .sampled = sample, .run = run_booth},
+        {.name = "barrett_reduce",    .domain = "x < Q^2",                     .size = qq,
+         .space = qq,             .run = run_barrett},
+        {.name = "barrett_reduce",    .domain = "x < 2^32",                    .size = 1ull << 32,
+         .space = 4294967296.0,   .run = run_barrett},
+        {.name = "montgomery_reduce", .domain = "T < Q * R",                   .size = (uint64_t)Q * _R,
+         .space = (double)Q * _R, .run = run_montgomery},
+        {.name = "montgomery mul",    .domain = "a, b < Q",    .range = Q,     .size = qq,
+         .space = qq,             .run = run_montgomery_mul},
+        {.name = "poly_basemul",      .domain = "a, b < Q",    .range = Q,     .size = qq,
+         .space = qq,             .run = run_basemul},
+        {.name = "poly_reduce",       .domain = "x < 2^16",                    .size = 1u << 16,
+         .space = 65536.0,        .run = run_reduce},
+    };
+    const int count = (int)(sizeof(checks) / sizeof(checks[0]));
+    uint64_t total_bad = 0;
+    int sampled = 0;
+    double total_s = 0;
+
+    printf("%-18s %-12s %14s %10s %11s %8s  %s\n", "check", "domain", "cases", "coverage", "mismatches", "time",
+           "run");
+    for (int i = 0; i < count; i++) {
+        check *c = &checks[i];
+        double s = run_check(c, threads);
+        total_s += s;
+        total_bad += c->mismatches;
+        sampled += c->sampled;
+        printf("%-18s %-12s %14llu %9.4g%% %11llu %7.2fs  %s\n", c->name, c->domain, (unsigned long long)c->size,
+               100.0 * c->size / c->space, (unsigned long long)c->mismatches, s,
+               c->sampled ? "SAMPLED" : "exhaustive");
+    }
+
+    // lazy-reduction bounds: the largest verified input of each reducer and what fits below it
+    check probe = {.name = "montgomery_reduce", .domain = "T >= Q * R", .size = PROBE_SPAN, .space = PROBE_SPAN,
+                   .run = run_montgomery_probe};
+    total_s += run_check(&probe, threads);
+    uint64_t max_prod = (uint64_t)(Q - 1) * (Q - 1);
+    uint64_t barrett_max = checks[3].mismatches == 0 ? UINT32_MAX : qq - 1;
+    uint64_t mont_max = (uint64_t)Q * _R - 1 + (probe.first_bad == UINT64_MAX ? PROBE_SPAN : probe.first_bad);
+
+    printf("\nlazy-reduction bounds (verified inputs, products of two values < Q, additions of values < Q)\n");
+    printf("  barrett_reduce     x <= %-11llu %5llu products\n", (unsigned long long)barrett_max,
+           (unsigned long long)(barrett_max / max_prod));
+    if (probe.first_bad == UINT64_MAX)
+        printf("  montgomery_reduce  T <= %-11llu %5llu products  (no failure within %u above Q * R)\n",
+               (unsigned long long)mont_max, (unsigned long long)(mont_max / max_prod), PROBE_SPAN);
+    else
+        printf("  montgomery_reduce  T <= %-11llu %5llu products  (first failure at Q * R + %llu)\n",
+               (unsigned long long)mont_max, (unsigned long long)(mont_max / max_prod),
+               (unsigned long long)probe.first_bad);
+    printf("  poly_reduce        x <= %-11u %5u additions\n", 65535u, 65535u / (Q - 1));
+
+    if (total_bad) {
+        printf("\nERROR: %llu mismatches (%d threads, %.2fs)\n", (unsigned long long)total_bad, threads, total_s);
+        return 1;
+    }
+    if (sampled) {
+        printf("\n%d exhaustive checks passed (%d threads, %.2fs)\n", count - sampled, threads, total_s);
+        printf("\nSAMPLED, NOT VERIFIED - no mismatch found, but only part of the space was run:\n");
+        for (int i = 0; i < count; i++) {
+            if (checks[i].sampled)
+                printf("  %s, %s: %.4g%% of the space (%llu of %.0f cases); run without 'sample' for all of it\n",
+                       checks[i].name, checks[i].domain, 100.0 * checks[i].size / checks[i].space,
+                       (unsigned long long)checks[i].size, checks[i].space);
+        }
+        return 0;
+    }
+    printf("\nall arithmetic checks passed exhaustively (%d threads, %.2fs)\n", threads, total_s);
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "pack.h"
+#include "kyber_params.h"
+
+#define RANDOM_POLYS 2000
+#define BENCH_ITERS  20000
+
+static const int widths[] = {1, 4, 5, 10, 11};
+#define WIDTH_COUNT ((int)(sizeof(widths) / sizeof(widths[0])))
+
+// small xorshift generator so runs are reproducible
+static uint32_t rng_state = 0x12345678;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void random_poly(uint16_t *a) {
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = rng() % Q;
+}
+
+static double elapsed_ns(struct timespec t0, struct timespec t1) {
+    return (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+}
+
+int main(void) {
+    uint16_t a[KYBER_POL_LENGTH], b[KYBER_POL_LENGTH], c[KYBER_POL_LENGTH];
+    uint8_t buf[KYBER_POLYBYTES], buf_ref[KYBER_POLYBYTES];
+    int errors = 0;
+
+    // multiply-shift rounding against exact division, whole input range
+    for (int k = 0; k < WIDTH_COUNT; k++) {
+        int d = widths[k];
+        for (uint32_t x = 0; x < Q; x++) {
+            uint16_t exact = (uint16_t)((((x << d) + Q / 2) / Q) & ((1 << d) - 1));
+            if (compress_d((uint16_t)x, d) != exact) {
+                printf("compress_%d(%u) = %u, expected %u\n", d, x, compress_d((uint16_t)x, d), exact);
+                errors++;
+                break;
+            }
+        }
+    }
+
+    for (int iter = 0; iter < RANDOM_POLYS; iter++) {
+        random_poly(a);
+        // first iterations hit the edges of the coefficient range
+        if (iter == 0) for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = Q - 1;
+        if (iter == 1) for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = 0;
+        if (iter == 2) for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = i % 2 ? Q - 1 : 0;
+
+        // 12-bit encoding
+        poly_tobytes(buf, a);
+        poly_tobytes_ref(buf_ref, a);
+        if (memcmp(buf, buf_ref, KYBER_POLYBYTES) != 0) {
+            printf("poly_tobytes mismatch (poly %d)\n", iter);
+            errors++;
+        }
+
+        poly_frombytes(b, buf);
+        if (memcmp(a, b, sizeof(a)) != 0) {
+            printf("poly_frombytes round trip mismatch (poly %d)\n", iter);
+            errors++;
+        }
+
+        for (int i = 0; i < KYBER_POLYBYTES; i++) buf[i] = (uint8_t)rng();
+        poly_frombytes(b, buf);
+        poly_frombytes_ref(c, buf);
+        if (memcmp(b, c, sizeof(b)) != 0) {
+            printf("poly_frombytes mismatch on random bytes (poly %d)\n", iter);
+            errors++;
+        }
+
+        // d-bit compression
+        for (int k = 0; k < WIDTH_COUNT; k++) {
+            int d = widths[k];
+            int len = KYBER_POLYCOMPRESSEDBYTES(d);
+
+            poly_compress(buf, a, d);
+            poly_compress_ref(buf_ref, a, d);
+            if (memcmp(buf, buf_ref, len) != 0) {
+                printf("poly_compress d=%d mismatch (poly %d)\n", d, iter);
+                errors++;
+            }
+
+            poly_decompress(b, buf, d);
+            poly_decompress_ref(c, buf, d);
+            if (memcmp(b, c, sizeof(b)) != 0) {
+                printf("poly_decompress d=%d mismatch (poly %d)\n", d, iter);
+                errors++;
+            }
+        }
+
+        if (errors) break;
+    }
+
+    if (poly_compress(buf, a, 3) != -1 || poly_decompress(b, buf, 12) != -1) {
+        printf("unsupported widths were accepted\n");
+        errors++;
+    }
+
+    if (errors) {
+        printf("\nERROR: %d mismatches\n", errors);
+        return 1;
+    }
+    printf("pack/compress cross-check passed (%d polynomials, d = 1 4 5 10 11 12)\n\n", RANDOM_POLYS);
+
+    // timing, fast kernels against the scalar reference
+    struct timespec t0, t1;
+    volatile uint8_t sink = 0;
+    random_poly(a);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_tobytes(buf, a); sink ^= buf[i % KYBER_POLYBYTES]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double fast = elapsed_ns(t0, t1) / BENCH_ITERS;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_tobytes_ref(buf, a); sink ^= buf[i % KYBER_POLYBYTES]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("poly_tobytes:      %8.1f ns (ref %8.1f ns)\n", fast, elapsed_ns(t0, t1) / BENCH_ITERS);
+
+    for (int k = 0; k < WIDTH_COUNT; k++) {
+        int d = widths[k];
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int i = 0; i < BENCH_ITERS; i++) { poly_compress(buf, a, d); sink ^= buf[0]; }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        fast = elapsed_ns(t0, t1) / BENCH_ITERS;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int i = 0; i < BENCH_ITERS; i++) { poly_compress_ref(buf, a, d); sink ^= buf[0]; }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        printf("poly_compress d=%-2d %8.1f ns (ref %8.1f ns)\n", d, fast, elapsed_ns(t0, t1) / BENCH_ITERS);
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int i = 0; i < BENCH_ITERS; i++) { poly_decompress(b, buf, d); sink ^= (uint8_t)b[0]; }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        fast = elapsed_ns(t0, t1) / BENCH_ITERS;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int i = 0; i < BENCH_ITERS; i++) { poly_decompress_ref(b, buf, d); sink ^= (uint8_t)b[0]; }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        printf("poly_decompress d=%-2d %6.1f ns (ref %8.1f ns)\n", d, fast, elapsed_ns(t0, t1) / BENCH_ITERS);
+    }
+
+    return 0;
+}
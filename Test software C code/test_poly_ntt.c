@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "ntt.h"
+#include "poly_ntt.h"
+#include "kyber_params.h"
+
+// Cross-checks the processor-side kernels (the generated transforms and poly_*_ref)
+// against references that share no code with them:
+// forward against ntt_standard, inverse as the exact inverse of ntt_standard
+// in both directions, basemul and reduction against plain % Q arithmetic, the latter
+// over every 16-bit input. Then times the kernels against poly_*_ref.
+
+#define RANDOM_POLYS 2000
+#define BENCH_ITERS  20000
+
+// small xorshift generator so runs are reproducible
+static uint32_t rng_state = 0x12345678;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void random_poly(uint16_t *a) {
+    for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = rng() % Q;
+}
+
+static double elapsed_ns(struct timespec t0, struct timespec t1) {
+    return (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+}
+
+int main(void) {
+    uint16_t a[KYBER_POL_LENGTH], b[KYBER_POL_LENGTH], c[KYBER_POL_LENGTH], d[KYBER_POL_LENGTH];
+    int errors = 0;
+
+    // Barrett reduction, whole 16-bit input range
+    for (uint32_t x = 0; x < 65536; x += KYBER_POL_LENGTH) {
+        for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = (uint16_t)(x + i);
+        poly_reduce(a);
+        for (int i = 0; i < KYBER_POL_LENGTH; i++) {
+            if (a[i] != (x + i) % Q) {
+                printf("poly_reduce(%u) = %u, expected %u\n", x + i, a[i], (x + i) % Q);
+                errors++;
+                break;
+            }
+        }
+    }
+
+    for (int iter = 0; iter < RANDOM_POLYS; iter++) {
+        random_poly(a);
+        random_poly(b);
+        // first iterations hit the edges of the coefficient range
+        if (iter == 0) for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = b[i] = Q - 1;
+        if (iter == 1) for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = b[i] = 0;
+        if (iter == 2) for (int i = 0; i < KYBER_POL_LENGTH; i++) a[i] = b[i] = i % 2 ? Q - 1 : 0;
+
+        // forward
+        memcpy(c, a, sizeof(a));
+        memcpy(d, a, sizeof(a));
+        poly_ntt(c);
+        ntt_standard(d, KYBER_POL_LENGTH, 910);
+        if (memcmp(c, d, sizeof(c)) != 0) {
+            printf("poly_ntt mismatch against ntt_standard (poly %d)\n", iter);
+            errors++;
+        }
+
+        // inverse: undoes ntt_standard, and ntt_standard undoes it on a random
+        // transform-domain input, so it is the inverse of ntt_standard
+        memcpy(c, d, sizeof(d));
+        poly_invntt(c);
+        if (memcmp(c, a, sizeof(c)) != 0) {
+            printf("poly_invntt(ntt_standard(a)) != a (poly %d)\n", iter);
+            errors++;
+        }
+        memcpy(c, b, sizeof(b));
+        poly_invntt(c);
+        ntt_standard(c, KYBER_POL_LENGTH, 910);
+        if (memcmp(c, b, sizeof(c)) != 0) {
+            printf("ntt_standard(poly_invntt(b)) != b (poly %d)\n", iter);
+            errors++;
+        }
+
+        // pointwise product, also in place
+        for (int i = 0; i < KYBER_POL_LENGTH; i++) d[i] = (uint16_t)((uint32_t)a[i] * b[i] % Q);
+        poly_basemul(c, a, b);
+        if (memcmp(c, d, sizeof(c)) != 0) {
+            printf("poly_basemul mismatch (poly %d)\n", iter);
+            errors++;
+        }
+        memcpy(c, a, sizeof(a));
+        poly_basemul(c, c, b);
+        if (memcmp(c, d, sizeof(c)) != 0) {
+            printf("poly_basemul in place mismatch (poly %d)\n", iter);
+            errors++;
+        }
+
+        if (errors) break;
+    }
+
+    if (errors) {
+        printf("\nERROR: %d mismatches\n", errors);
+        return 1;
+    }
+    printf("poly_ntt cross-check passed (generated/scalar kernels, %d polynomials, reduction over all 16-bit inputs)\n\n",
+           RANDOM_POLYS);
+
+    // timing, fast kernels against the scalar reference
+    struct timespec t0, t1;
+    volatile uint16_t sink = 0;
+    double fast;
+    random_poly(a);
+    random_poly(b);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_ntt(a); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    fast = elapsed_ns(t0, t1) / BENCH_ITERS;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_ntt_ref(a); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("poly_ntt:     %8.1f ns (ref %8.1f ns)\n", fast, elapsed_ns(t0, t1) / BENCH_ITERS);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_invntt(a); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    fast = elapsed_ns(t0, t1) / BENCH_ITERS;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_invntt_ref(a); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("poly_invntt:  %8.1f ns (ref %8.1f ns)\n", fast, elapsed_ns(t0, t1) / BENCH_ITERS);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_basemul(a, a, b); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    fast = elapsed_ns(t0, t1) / BENCH_ITERS;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { poly_basemul_ref(a, a, b); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("poly_basemul: %8.1f ns (ref %8.1f ns)\n", fast, elapsed_ns(t0, t1) / BENCH_ITERS);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { a[i % KYBER_POL_LENGTH] += (uint16_t)i; poly_reduce(a); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    fast = elapsed_ns(t0, t1) / BENCH_ITERS;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < BENCH_ITERS; i++) { a[i % KYBER_POL_LENGTH] += (uint16_t)i; poly_reduce_ref(a); sink ^= a[0]; }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("poly_reduce:  %8.1f ns (ref %8.1f ns)\n", fast, elapsed_ns(t0, t1) / BENCH_ITERS);
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "ntt.h"
+#include "poly_ntt.h"
+#include "kyber_params.h"
+#include "kyber_consts.h"
+#include "dilithium_hw_consts.h"
+
+// Checks the gen_tables output: the constants against their defining relations, the
+// straight-line kernels against ntt_standard / the scalar inverse (Kyber) and against a
+// loop over the generated tables (Dilithium), round trips for both. Then times one
+// transform: ntt_standard, the loop reference, the processor kernel and the unrolled one.
+
+#define RANDOM_POLYS 1000
+#define BENCH_ITERS  2000
+#define BENCH_ROUNDS 15     //fastest round is reported, this machine's noise is mostly one-sided
+
+static uint32_t rng_state = 0x9e3779b9;
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static double elapsed_ns(struct timespec t0, struct timespec t1) {
+    return (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+}
+
+static uint64_t pow_mod(uint64_t b, uint64_t e, uint64_t q) {
+    uint64_t r = 1;
+    b %= q;
+    while (e) {
+        if (e & 1) r = r * b % q;
+        b = b * b % q;
+        e >>= 1;
+    }
+    return r;
+}
+
+static int check(int ok, const char *what) {
+    if (!ok) printf("FAILED: %s\n", what);
+    return !ok;
+}
+
+static int check_constants(void) {
+    int errors = 0;
+    errors += check((uint16_t)(KYBER_QINV * KYBER_Q) == 1, "KYBER_QINV * Q = 1 mod 2^16");
+    errors += check((uint16_t)(KYBER_QINV_NEG * KYBER_Q) == 0xffff, "KYBER_QINV_NEG * Q = -1 mod 2^16");
+    errors += check(KYBER_RINV * 65536u % KYBER_Q == 1, "KYBER_RINV * 2^16 = 1 mod Q");
+    errors += check(KYBER_R2 == (1ull << 32) % KYBER_Q, "KYBER_R2 = 2^32 mod Q");
+    errors += check(KYBER_OMEGA * KYBER_OMEGA_INV % KYBER_Q == 1, "KYBER_OMEGA * KYBER_OMEGA_INV = 1");
+    errors += check(pow_mod(KYBER_OMEGA, KYBER_N / 4, KYBER_Q) == KYBER_Q - 1, "KYBER_OMEGA has order N/2");
+    errors += check((uint32_t)(DILITHIUM_HW_QINV * DILITHIUM_HW_Q) == 1, "DILITHIUM_HW_QINV * Q = 1 mod 2^32");
+    errors += check(DILITHIUM_HW_RINV * (1ull << 32) % DILITHIUM_HW_Q == 1, "DILITHIUM_HW_RINV * 2^32 = 1 mod Q");
+    errors += check(pow_mod(DILITHIUM_HW_OMEGA, DILITHIUM_HW_N / 4, DILITHIUM_HW_Q) == DILITHIUM_HW_Q - 1,
+                    "DILITHIUM_HW_OMEGA has order N/2");
+    for (int i = 0; i < KYBER_N / 2; i++) {
+        int rev = bit_reverse(i, KYBER_LOGN - 1);
+        if (kyber_zetas[0][i] != mod_pow(KYBER_OMEGA, rev) || kyber_zetas[1][i] != mod_pow(KYBER_OMEGA_INV, rev) ||
+            kyber_zetas_mont[0][i] != ((uint32_t)kyber_zetas[0][i] << 16) % KYBER_Q ||
+            (uint16_t)(kyber_zetas_mont[0][i] * KYBER_QINV) != kyber_zetas_mont_qinv[0][i] ||
+            dilithium_hw_zetas[0][i] != pow_mod(DILITHIUM_HW_OMEGA, rev, DILITHIUM_HW_Q)) {
+            printf("FAILED: twiddle table entry %d\n", i);
+            errors++;
+            break;
+        }
+    }
+    return errors;
+}
+
+// the generated Dilithium tables in the ntt_standard loop, as the reference for the unrolled kernel
+static void dilithium_loop_ntt(uint32_t *a) {
+    for (int len = DILITHIUM_HW_N / 2; len >= 1; len >>= 1) {
+        int step = DILITHIUM_HW_N / (2 * len);
+        for (int start = 0; start < DILITHIUM_HW_N; start += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                uint64_t u = a[start + j];
+                uint64_t v = (uint64_t)a[start + j + len] * dilithium_hw_zetas[0][j * step] % DILITHIUM_HW_Q;
+                a[start + j] = (uint32_t)((u + v) % DILITHIUM_HW_Q);
+                a[start + j + len] = (uint32_t)((u + DILITHIUM_HW_Q - v) % DILITHIUM_HW_Q);
+            }
+        }
+    }
+}
+
+int main(void) {
+    uint16_t a[KYBER_N], b[KYBER_N], c[KYBER_N];
+    uint32_t x[DILITHIUM_HW_N], y[DILITHIUM_HW_N], z[DILITHIUM_HW_N];
+    int errors = check_constants();
+
+    for (int iter = 0; iter < RANDOM_POLYS && !errors; iter++) {
+        for (int i = 0; i < KYBER_N; i++)
+            a[i] = (uint16_t)(iter == 0 ? KYBER_Q - 1 : iter == 1 ? 0 : rng() % KYBER_Q);
+        for (int i = 0; i < DILITHIUM_HW_N; i++)
+            x[i] = iter == 0 ? DILITHIUM_HW_Q - 1 : iter == 1 ? 0 : rng() % DILITHIUM_HW_Q;
+
+        memcpy(b, a, sizeof(a));
+        memcpy(c, a, sizeof(a));
+        kyber_ntt_unrolled(b);
+        ntt_standard(c, KYBER_N, KYBER_OMEGA);
+        errors += check(memcmp(b, c, sizeof(b)) == 0, "kyber_ntt_unrolled against ntt_standard");
+        memcpy(c, b, sizeof(b));
+        kyber_intt_unrolled(b);
+        poly_invntt_ref(c);
+        errors += check(memcmp(b, c, sizeof(b)) == 0, "kyber_intt_unrolled against poly_invntt_ref");
+        errors += check(memcmp(b, a, sizeof(b)) == 0, "kyber round trip");
+
+        memcpy(y, x, sizeof(x));
+        memcpy(z, x, sizeof(x));
+        dilithium_hw_ntt_unrolled(y);
+        dilithium_loop_ntt(z);
+        errors += check(memcmp(y, z, sizeof(y)) == 0, "dilithium_hw_ntt_unrolled against the table loop");
+        dilithium_hw_intt_unrolled(y);
+        errors += check(memcmp(y, x, sizeof(y)) == 0, "dilithium_hw round trip");
+    }
+
+    if (errors) {
+        printf("\nERROR: %d failed checks\n", errors);
+        return 1;
+    }
+    printf("generated constants and unrolled kernels check out (%d polynomials, %s / %s kernels)\n\n",
+           RANDOM_POLYS, KYBER_REDUCTION, DILITHIUM_HW_REDUCTION);
+
+    // single-transform latency
+    struct timespec t0, t1;
+    volatile uint32_t sink = 0;
+
+#define TIME(label, stmt)                                                   \
+    do {                                                                    \
+        double best = 0;                                                    \
+        for (int r = 0; r < BENCH_ROUNDS; r++) {                            \
+            clock_gettime(CLOCK_MONOTONIC, &t0);                            \
+            for (int i = 0; i < BENCH_ITERS; i++) { stmt; }                 \
+            clock_gettime(CLOCK_MONOTONIC, &t1);                            \
+            if (r == 0 || elapsed_ns(t0, t1) < best) best = elapsed_ns(t0, t1); \
+        }                                                                   \
+        printf("%-28s %8.1f ns\n", label, best / BENCH_ITERS);               \
+    } while (0)
+
+    TIME("ntt_standard",             ntt_standard(a, KYBER_N, KYBER_OMEGA); sink ^= a[0]);
+    TIME("poly_ntt_ref",             poly_ntt_ref(a); sink ^= a[0]);
+    TIME("poly_ntt",                 poly_ntt(a); sink ^= a[0]);
+    TIME("kyber_ntt_unrolled",       kyber_ntt_unrolled(a); sink ^= a[0]);
+    TIME("poly_invntt_ref",          poly_invntt_ref(a); sink ^= a[0]);
+    TIME("poly_invntt",              poly_invntt(a); sink ^= a[0]);
+    TIME("kyber_intt_unrolled",      kyber_intt_unrolled(a); sink ^= a[0]);
+    TIME("dilithium_loop_ntt",       dilithium_loop_ntt(x); sink ^= x[0]);
+    TIME("dilithium_hw_ntt_unrolled", dilithium_hw_ntt_unrolled(x); sink ^= x[0]);
+    TIME("dilithium_hw_intt_unrolled", dilithium_hw_intt_unrolled(x); sink ^= x[0]);
+#undef TIME
+
+    return 0;
+}
@@ -8,6 +8,8 @@
 #include "xaxicdma.h"
 #include "xaxicdma_hw.h"
 #include "xtime_l.h"
+#include "ntt_pool.h"
+#include "ntt_perf.h"
 
 // --- Print Macros ------------------------------------------------------------
 #define DEBUG_PRINTS  0     // set to 0 to disable debug prints
@@ -26,29 +28,23 @@
 #endif
 
 // --- Configuration Constants -------------------------------------------------
-#define COEFF_COUNT             256
-#define TRANSFER_LEN_BYTES      (COEFF_COUNT * sizeof(u32))
-
-// Base Addresses
-#define BRAM_BASE_ADDR          XPAR_AXI_NTT_UNIT_0_S01_AXI_BASEADDR
-#define NTT_CTRL_ADDR           XPAR_AXI_NTT_UNIT_0_S00_AXI_BASEADDR
-
-// Interrupt IDs
-#define NTT_IRQ_ID              XPAR_FABRIC_AXI_NTT_UNIT_0_VEC_ID
+#define COEFF_COUNT             NTT_COEFF_COUNT
+#define TRANSFER_LEN_BYTES      NTT_TRANSFER_LEN_BYTES
+#define BATCH_JOBS              16      // transforms spread across all NTT instances
+#define VECTOR_POLYS            NTT_POOL_MAX_POLYS  // Kyber-1024 vector, one command
+#define REF_Q                   3329    // primary scheme of the unit (Kyber)
+#define REF_OMEGA               910     // twiddle_ROM root, order 128
+#define REF_OMEGA_INV           3040
+
+// Interrupt IDs (NTT instance IDs come from NttUnit_ConfigTable)
 #define CDMA_IRQ_ID             XPAR_FABRIC_AXICDMA_0_VEC_ID
 
-// NTT Control Offsets
-#define NTT_AP_CTRL             0x00
-#define NTT_IRQ_CLEAR           0x04
-#define NTT_MODE_FORWARD        0
-#define NTT_MODE_INVERSE        1
-
 // --- Global Variables --------------------------------------------------------
 static XAxiCdma AxiCdmaInstance;
 static XScuGic GicInstance;
+static NttPool Pool;
 
 volatile static int DmaDone = 0;
-volatile static int NttDone = 0;
 
 XTime t_start, t_end;
 
@@ -56,12 +52,17 @@ XTime t_start, t_end;
 // Input and output buffers
 static volatile u32 Input_coeffs  [COEFF_COUNT] __attribute__ ((aligned(32)));
 static volatile u32 Output_coeffs [COEFF_COUNT] __attribute__ ((aligned(32)));
+static u32 Batch_coeffs [BATCH_JOBS][COEFF_COUNT] __attribute__ ((aligned(32)));
+static u32 Vector_coeffs[VECTOR_POLYS][COEFF_COUNT] __attribute__ ((aligned(32)));
 
 // --- Function Prototypes -----------------------------------------------------
 int Setup_Interrupt_System(XScuGic *GicInstancePtr);
 void DmaIsr(void *CallbackRef);
-void NttIsr(void *CallbackRef);
 int NTT_Transfer_And_Execute(u32 *SrcAddr, u32 *DestAddr, u32 NttMode);
+int NTT_Batch_Execute(u32 NttMode);
+int NTT_Vector_Execute(u32 NttMode, u32 Count);
+void Ntt_Reference(u32 *Coeffs, u32 NttMode);
+int Cdma_Copy(void *CopyRef, UINTPTR Src, UINTPTR Dest, u32 Len, int Direction);
 int Setup_CDMA(void);
 int Reset_CDMA(XAxiCdma *InstancePtr);
 
@@ -108,17 +109,38 @@ void DmaIsr(void *CallbackRef)
 }
 
 // -----------------------------------------------------------------------------
-// NTT Interrupt Handler
+// CDMA copy between DDR and an NTT instance's BRAM (NttPool copy callback)
+// A vector job is contiguous on both sides, so all of its polynomials move in a
+// single simple transfer (the CDMA is built without scatter-gather).
 // -----------------------------------------------------------------------------
-void NttIsr(void *CallbackRef)
+int Cdma_Copy(void *CopyRef, UINTPTR Src, UINTPTR Dest, u32 Len, int Direction)
 {
-    if (!NttDone) {
-        Xil_Out32(NTT_CTRL_ADDR + NTT_IRQ_CLEAR, 1);
-        NttDone = 1;
-        XScuGic_Disable(&GicInstance, NTT_IRQ_ID);
-        usleep(1);
-        Xil_Out32(NTT_CTRL_ADDR + NTT_IRQ_CLEAR, 0);
+    XAxiCdma *InstancePtr = (XAxiCdma *)CopyRef;
+    int Status;
+
+    DmaDone = 0;
+    Status = Reset_CDMA(InstancePtr);
+    if (Status != XST_SUCCESS) return Status;
+
+    if (Direction == NTT_COPY_TO_DEVICE)
+        Xil_DCacheFlushRange(Src, Len);
+    else
+        Xil_DCacheInvalidateRange(Dest, Len);
+
+    DmaDone = 0;
+    Status = XAxiCdma_SimpleTransfer(InstancePtr, Src, Dest, Len, NULL, NULL);
+    if (Status != XST_SUCCESS) {
+        xil_printf("ERROR: CDMA Transfer failed (%s).\r\n",
+                   Direction == NTT_COPY_TO_DEVICE ? "DRAM -> BRAM" : "BRAM -> DRAM");
+        return Status;
     }
+
+    while (!DmaDone) {}
+
+    if (Direction == NTT_COPY_FROM_DEVICE)
+        Xil_DCacheInvalidateRange(Dest, Len);
+
+    return XST_SUCCESS;
 }
 
 // -----------------------------------------------------------------------------
@@ -155,6 +177,7 @@ int Setup_Interrupt_System(XScuGic *GicInstancePtr)
 {
     XScuGic_Config *GicConfig;
     int Status;
+    u32 i;
 
     GicConfig = XScuGic_LookupConfig(XPAR_SCUGIC_0_DEVICE_ID);
     if (!GicConfig) return XST_FAILURE;
@@ -172,13 +195,17 @@ int Setup_Interrupt_System(XScuGic *GicInstancePtr)
                              (void *)&AxiCdmaInstance);
     if (Status != XST_SUCCESS) return XST_FAILURE;
 
-    Status = XScuGic_Connect(GicInstancePtr, NTT_IRQ_ID,
-                             (Xil_ExceptionHandler)NttIsr,
-                             (void *)NTT_CTRL_ADDR);
-    if (Status != XST_SUCCESS) return XST_FAILURE;
+    // one handler per NTT instance, each with its own state
+    for (i = 0; i < Pool.NumUnits; i++) {
+        Status = XScuGic_Connect(GicInstancePtr, Pool.Units[i].Config.IrqId,
+                                 (Xil_ExceptionHandler)NttPool_Isr,
+                                 (void *)&Pool.Units[i]);
+        if (Status != XST_SUCCESS) return XST_FAILURE;
+    }
 
     XScuGic_Enable(GicInstancePtr, CDMA_IRQ_ID);
-    XScuGic_Enable(GicInstancePtr, NTT_IRQ_ID);
+    for (i = 0; i < Pool.NumUnits; i++)
+        XScuGic_Enable(GicInstancePtr, Pool.Units[i].Config.IrqId);
 
     DPRINT("Interrupt System Setup Complete.\r\n");
     return XST_SUCCESS;
@@ -190,66 +217,180 @@ int Setup_Interrupt_System(XScuGic *GicInstancePtr)
 int NTT_Transfer_And_Execute(u32 input_coeffs[], u32 output_coeffs[], u32 NttMode)
 {
     int Status;
+    NttJob Job;
     const char *ModeStr = (NttMode == NTT_MODE_FORWARD) ? "NTT (Forward)" : "INTT (Inverse)";
 
     XTime_GetTime(&t_start); // start timing
     DPRINT("\nStarting %s Cycle...\r\n", ModeStr);
 
-    // --- Step 1: DRAM -> BRAM ---
-    DmaDone = 0;
-    Status = Reset_CDMA(&AxiCdmaInstance);
+    Job.Src   = input_coeffs;
+    Job.Dest  = output_coeffs;
+    Job.Mode  = NttMode;
+    Job.Count = 1;
+    Job.Scheme = NTT_SCHEME_PRIMARY;
+
+    // DRAM -> BRAM, start and BRAM -> DRAM all happen inside the pool
+    Status = NttPool_Submit(&Pool, &Job);
     if (Status != XST_SUCCESS) return Status;
 
-    Xil_DCacheFlushRange((UINTPTR)input_coeffs, TRANSFER_LEN_BYTES);
+    Status = NttPool_Wait(&Pool, &Job);
+    if (Status != XST_SUCCESS) return Status;
 
-    DmaDone = 0;
-    Status = XAxiCdma_SimpleTransfer(&AxiCdmaInstance,
-                                     (UINTPTR)input_coeffs,
-                                     BRAM_BASE_ADDR,
-                                     TRANSFER_LEN_BYTES,
-                                     NULL, NULL);
-    if (Status != XST_SUCCESS) {
-        xil_printf("ERROR: CDMA Transfer failed (DRAM -> BRAM).\r\n");
-        return Status;
+    XTime_GetTime(&t_end); // end timing
+
+    DPRINT("%s Cycle Complete (instance %d).\r\n", ModeStr, Job.Unit);
+#if TIMING_PRINTS
+    NttPerf_Report(ModeStr, &Job.Perf, (t_end - t_start) * (u64)NTT_CLK_HZ / COUNTS_PER_SECOND);
+#endif
+    return XST_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Software transform the unit must reproduce: ntt_standard(a, 256, 910) /
+// intt_standard(a, 256, 3040) of the C model, the inverse halving every stage
+// -----------------------------------------------------------------------------
+static u32 Ref_PowMod(u32 Base, u32 Exp)
+{
+    u32 Result = 1;
+
+    while (Exp) {
+        if (Exp & 1) Result = Result * Base % REF_Q;
+        Base = Base * Base % REF_Q;
+        Exp >>= 1;
     }
+    return Result;
+}
 
-    while (!DmaDone) {}
+static u32 Ref_Half(u32 X)
+{
+    return (X & 1) ? (REF_Q - 1) / 2 + (X + 1) / 2 : X / 2;
+}
 
-    // --- Step 2: Start NTT ---
-    NttDone = 0;
-    XScuGic_Enable(&GicInstance, NTT_IRQ_ID);
+void Ntt_Reference(u32 *Coeffs, u32 NttMode)
+{
+    u32 Omega = (NttMode == NTT_MODE_FORWARD) ? REF_OMEGA : REF_OMEGA_INV;
+    int Stage, Start, j, k;
+
+    // forward distances 128 .. 1, inverse 1 .. 128
+    for (Stage = 0; Stage < 8; Stage++) {
+        int Len  = (NttMode == NTT_MODE_FORWARD) ? (COEFF_COUNT / 2) >> Stage : 1 << Stage;
+        int Step = COEFF_COUNT / (2 * Len);
+
+        for (Start = 0; Start < COEFF_COUNT; Start += 2 * Len) {
+            for (j = 0; j < Len; j++) {
+                int Index = j * Step, Rev = 0;
+                for (k = 0; k < 7; k++) Rev = (Rev << 1) | ((Index >> k) & 1);
+
+                u32 W = Ref_PowMod(Omega, Rev);
+                u32 U = Coeffs[Start + j];
+                u32 V = Coeffs[Start + j + Len];
+
+                if (NttMode == NTT_MODE_FORWARD) {
+                    V = V * W % REF_Q;
+                    Coeffs[Start + j]       = (U + V) % REF_Q;
+                    Coeffs[Start + j + Len] = (U + REF_Q - V) % REF_Q;
+                } else {
+                    Coeffs[Start + j]       = Ref_Half((U + V) % REF_Q);
+                    Coeffs[Start + j + Len] = Ref_Half((U + REF_Q - V) % REF_Q * W % REF_Q);
+                }
+            }
+        }
+    }
+}
 
+// -----------------------------------------------------------------------------
+// Batch of independent transforms, distributed by least outstanding work
+// Jobs run in place; every result is checked against Ntt_Reference of its input
+// -----------------------------------------------------------------------------
+int NTT_Batch_Execute(u32 NttMode)
+{
+    static NttJob Jobs[BATCH_JOBS];
+    static u32 Expected[BATCH_JOBS][COEFF_COUNT];
+    int i, k, Submitted = 0;
+    u32 u;
+
+    for (i = 0; i < BATCH_JOBS; i++) {
+        for (k = 0; k < COEFF_COUNT; k++)
+            Expected[i][k] = Batch_coeffs[i][k];
+        Ntt_Reference(Expected[i], NttMode);
+    }
 
-    Xil_Out32(NTT_CTRL_ADDR + NTT_AP_CTRL, 0x01 | (NttMode ? 0x02 : 0x0));
-    Xil_Out32(NTT_CTRL_ADDR + NTT_AP_CTRL, 0x0);
+    for (u = 0; u < Pool.NumUnits; u++)
+        NttPerf_ClearTotals(Pool.Units[u].Config.CtrlBaseAddr);
 
-    while (!NttDone) {}
+    XTime_GetTime(&t_start);
 
+    while (Submitted < BATCH_JOBS) {
+        Jobs[Submitted].Src  = Batch_coeffs[Submitted];
+        Jobs[Submitted].Dest = Batch_coeffs[Submitted];
+        Jobs[Submitted].Mode = NttMode;
+        Jobs[Submitted].Count = 1;
+        Jobs[Submitted].Scheme = NTT_SCHEME_PRIMARY;
 
-    // --- Step 3: BRAM -> DRAM ---
-    DmaDone = 0;
-    Status = Reset_CDMA(&AxiCdmaInstance);
-    if (Status != XST_SUCCESS) return Status;
+        if (NttPool_Submit(&Pool, &Jobs[Submitted]) == XST_SUCCESS)
+            Submitted++;
+        else
+            NttPool_Poll(&Pool);    // all queues full
+    }
 
-    Xil_DCacheInvalidateRange((UINTPTR)output_coeffs, TRANSFER_LEN_BYTES);
+    while (NttPool_Poll(&Pool) > 0) {}
 
-    DmaDone = 0;
-    Status = XAxiCdma_SimpleTransfer(&AxiCdmaInstance,
-                                     BRAM_BASE_ADDR,
-                                     (UINTPTR)output_coeffs,
-                                     TRANSFER_LEN_BYTES,
-                                     NULL, NULL);
-    if (Status != XST_SUCCESS) {
-        xil_printf("ERROR: CDMA Transfer failed (BRAM -> DRAM).\r\n");
-        return Status;
+    XTime_GetTime(&t_end);
+
+    for (i = 0; i < BATCH_JOBS; i++) {
+        if (Jobs[i].Status != XST_SUCCESS) return Jobs[i].Status;
     }
 
-    while (!DmaDone) {}
-    Xil_DCacheInvalidateRange((UINTPTR)output_coeffs, TRANSFER_LEN_BYTES);
+    for (i = 0; i < BATCH_JOBS; i++) {
+        for (k = 0; k < COEFF_COUNT; k++) {
+            if (Batch_coeffs[i][k] != Expected[i][k]) {
+                xil_printf("BATCH ERROR: job %d (instance %d) coeff %d: %u, expected %u\r\n",
+                           i, Jobs[i].Unit, k, Batch_coeffs[i][k], Expected[i][k]);
+                return XST_FAILURE;
+            }
+        }
+    }
+    xil_printf("Batch results match the software NTT.\r\n");
 
-    XTime_GetTime(&t_end); // end timing
+    for (u = 0; u < Pool.NumUnits; u++) {
+        TPRINT("  instance %u: %u jobs\r\n", u, Pool.Units[u].JobsCompleted);
+#if TIMING_PRINTS
+        NttPerf Totals;
+        NttPerf_Read(Pool.Units[u].Config.CtrlBaseAddr, NTT_PERF_BANK_TOTAL, &Totals);
+        NttPerf_Report("  batch", &Totals, (t_end - t_start) * (u64)NTT_CLK_HZ / COUNTS_PER_SECOND);
+#endif
+    }
+
+    return XST_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Vector of Count polynomials in place: one DMA per direction, one start, one IRQ
+// -----------------------------------------------------------------------------
+int NTT_Vector_Execute(u32 NttMode, u32 Count)
+{
+    NttJob Job;
+    int Status;
+
+    Job.Src   = Vector_coeffs[0];
+    Job.Dest  = Vector_coeffs[0];
+    Job.Mode  = NttMode;
+    Job.Count = Count;
+    Job.Scheme = NTT_SCHEME_PRIMARY;
+
+    XTime_GetTime(&t_start);
+
+    Status = NttPool_Submit(&Pool, &Job);
+    if (Status != XST_SUCCESS) return Status;
 
-    DPRINT("%s Cycle Complete.\r\n", ModeStr);
+    Status = NttPool_Wait(&Pool, &Job);
+    if (Status != XST_SUCCESS) return Status;
+
+    XTime_GetTime(&t_end);
+
+#if TIMING_PRINTS
+    NttPerf_Report("  vector", &Job.Perf, (t_end - t_start) * (u64)NTT_CLK_HZ / COUNTS_PER_SECOND);
+#endif
     return XST_SUCCESS;
 }
 
@@ -272,6 +413,12 @@ int main()
     Status = Setup_CDMA();
     if (Status != XST_SUCCESS) return XST_FAILURE;
 
+    Status = NttPool_Initialize(&Pool, NttUnit_ConfigTable, NttUnit_ConfigCount,
+                                Cdma_Copy, &AxiCdmaInstance);
+    if (Status != XST_SUCCESS) return XST_FAILURE;
+    xil_printf("NTT instances: %u\r\n", Pool.NumUnits);
+    Pool.CollectPerf = TIMING_PRINTS;
+
     Status = Setup_Interrupt_System(&GicInstance);
     if (Status != XST_SUCCESS) return XST_FAILURE;
 
@@ -338,10 +485,52 @@ int main()
     xil_printf("Restored Coeffs[0]: %u (Expected: %u)\r\n", Input_coeffs[0], (u32)0);
     xil_printf("Restored Coeffs[255]: %u (Expected: %u)\r\n", Input_coeffs[255], (u32)255);
 
-    if (Match)
-        xil_printf("RESULT: PASS — Data restored successfully.\r\n");
-    else
-        xil_printf("RESULT: WARNING — Data mismatch (missing scaling factor?)\r\n");
+    // the hardware INTT halves every stage (n^-1 folded in), so the round trip is exact
+    if (!Match) {
+        xil_printf("RESULT: FAIL — Data not restored.\r\n");
+        return XST_FAILURE;
+    }
+    xil_printf("RESULT: PASS — Data restored successfully.\r\n");
+
+    // --- Batch across all instances ---
+    for (i = 0; i < BATCH_JOBS; i++) {
+        for (int k = 0; k < COEFF_COUNT; k++)
+            Batch_coeffs[i][k] = (i + k) % 3329;
+    }
+
+    Status = NTT_Batch_Execute(NTT_MODE_FORWARD);
+
+    elapsed_us = (double)(t_end - t_start) / (COUNTS_PER_SECOND / 1000000.0);
+    elapsed_us_int = (int)elapsed_us;
+    TPRINT("Batch of %u NTTs runtime: %u us\r\n", BATCH_JOBS, elapsed_us_int);
+
+    if (Status != XST_SUCCESS) return XST_FAILURE;
+
+    // --- Vector command: forward + inverse over all banks ---
+    for (i = 0; i < VECTOR_POLYS; i++) {
+        for (int k = 0; k < COEFF_COUNT; k++)
+            Vector_coeffs[i][k] = (7 * i + k) % 3329;
+    }
+
+    Status = NTT_Vector_Execute(NTT_MODE_FORWARD, VECTOR_POLYS);
+    elapsed_us_int = (int)((double)(t_end - t_start) / (COUNTS_PER_SECOND / 1000000.0));
+    TPRINT("Vector of %u NTTs runtime: %u us\r\n", VECTOR_POLYS, elapsed_us_int);
+    if (Status != XST_SUCCESS) return XST_FAILURE;
+
+    Status = NTT_Vector_Execute(NTT_MODE_INVERSE, VECTOR_POLYS);
+    elapsed_us_int = (int)((double)(t_end - t_start) / (COUNTS_PER_SECOND / 1000000.0));
+    TPRINT("Vector of %u INTTs runtime: %u us\r\n", VECTOR_POLYS, elapsed_us_int);
+    if (Status != XST_SUCCESS) return XST_FAILURE;
+
+    for (i = 0; i < VECTOR_POLYS; i++) {
+        for (int k = 0; k < COEFF_COUNT; k++) {
+            if (Vector_coeffs[i][k] != (u32)((7 * i + k) % 3329)) {
+                xil_printf("VECTOR ERROR: polynomial %u coeff %u not restored\r\n", i, k);
+                return XST_FAILURE;
+            }
+        }
+    }
+    xil_printf("Vector round trip OK.\r\n");
 
     xil_printf("--- Test Complete ---\r\n");
     return 0;
@@ -0,0 +1,62 @@
+#include <xil_io.h>
+#include <xil_printf.h>
+#include "ntt_perf.h"
+
+// -----------------------------------------------------------------------------
+// Counter access
+// -----------------------------------------------------------------------------
+static u32 NttPerf_ReadCounter(UINTPTR CtrlBaseAddr, u32 Select)
+{
+    Xil_Out32(CtrlBaseAddr + NTT_PERF_CTRL, Select);
+    return Xil_In32(CtrlBaseAddr + NTT_PERF_DATA);
+}
+
+void NttPerf_Read(UINTPTR CtrlBaseAddr, int Bank, NttPerf *Perf)
+{
+    u32 Sel = (Bank == NTT_PERF_BANK_TOTAL) ? NTT_PERF_SEL_TOTAL : 0;
+    int s;
+
+    Perf->Busy = NttPerf_ReadCounter(CtrlBaseAddr, Sel | NTT_PERF_BUSY);
+    for (s = 0; s < NTT_PERF_STAGES; s++)
+        Perf->Stage[s] = NttPerf_ReadCounter(CtrlBaseAddr, Sel | (NTT_PERF_STAGE0 + s));
+    Perf->FlushStall    = NttPerf_ReadCounter(CtrlBaseAddr, Sel | NTT_PERF_FLUSH);
+    Perf->InttWaitStall = NttPerf_ReadCounter(CtrlBaseAddr, Sel | NTT_PERF_INTT_WAIT);
+    Perf->Issued        = NttPerf_ReadCounter(CtrlBaseAddr, Sel | NTT_PERF_ISSUE);
+    Perf->BramConflicts = NttPerf_ReadCounter(CtrlBaseAddr, Sel | NTT_PERF_CONFLICT);
+    Perf->Jobs          = NttPerf_ReadCounter(CtrlBaseAddr, Sel | NTT_PERF_JOBS);
+}
+
+void NttPerf_ClearTotals(UINTPTR CtrlBaseAddr)
+{
+    // the free-running bank is held at zero while the clear bit is set
+    Xil_Out32(CtrlBaseAddr + NTT_PERF_CTRL, NTT_PERF_CLEAR);
+    Xil_Out32(CtrlBaseAddr + NTT_PERF_CTRL, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Report
+// -----------------------------------------------------------------------------
+void NttPerf_Report(const char *Label, const NttPerf *Perf, u64 WallCycles)
+{
+    u32 StageSum = 0, SwapStall;
+    int s;
+
+    for (s = 0; s < NTT_PERF_STAGES; s++)
+        StageSum += Perf->Stage[s];
+    // stage cycles without an issued butterfly: bank swaps between stages
+    SwapStall = (StageSum > Perf->Issued) ? StageSum - Perf->Issued : 0;
+
+    xil_printf("%s: %u job(s), %u busy cycles\r\n", Label, Perf->Jobs, Perf->Busy);
+    xil_printf("  compute:  %u butterfly cycles\r\n", Perf->Issued);
+    xil_printf("  stalls:   %u bank swap, %u flush, %u INTT wait\r\n",
+               SwapStall, Perf->FlushStall, Perf->InttWaitStall);
+    xil_printf("  stages:  ");
+    for (s = 0; s < NTT_PERF_STAGES; s++)
+        xil_printf(" %u", Perf->Stage[s]);
+    xil_printf("\r\n");
+    xil_printf("  BRAM port conflicts: %u\r\n", Perf->BramConflicts);
+
+    if (WallCycles > Perf->Busy)
+        xil_printf("  outside the core (DMA + driver): %u of %u cycles\r\n",
+                   (u32)(WallCycles - Perf->Busy), (u32)WallCycles);
+}
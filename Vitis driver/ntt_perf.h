@@ -0,0 +1,48 @@
+#ifndef NTT_PERF_H
+#define NTT_PERF_H
+
+#include "xil_types.h"
+
+// --- Performance counter registers (S00_AXI) -----------------------------------
+#define NTT_PERF_CTRL           0x08    // [4:0] counter select, [31] clear free-running bank
+#define NTT_PERF_DATA           0x0C    // selected counter (read only)
+#define NTT_PERF_SEL_TOTAL      0x10    // select bit 4: free-running bank instead of last job
+#define NTT_PERF_CLEAR          0x80000000u
+
+#define NTT_PERF_BANK_JOB       0       // last (or current) job, restarts when a job starts
+#define NTT_PERF_BANK_TOTAL     1       // free running since the last NttPerf_ClearTotals
+
+// Counter indices, same order as NTT_perf_counters.sv
+#define NTT_PERF_STAGES         8
+#define NTT_PERF_BUSY           0
+#define NTT_PERF_STAGE0         1
+#define NTT_PERF_FLUSH          (NTT_PERF_STAGE0 + NTT_PERF_STAGES)
+#define NTT_PERF_INTT_WAIT      (NTT_PERF_FLUSH + 1)
+#define NTT_PERF_ISSUE          (NTT_PERF_FLUSH + 2)
+#define NTT_PERF_CONFLICT       (NTT_PERF_FLUSH + 3)
+#define NTT_PERF_JOBS           (NTT_PERF_FLUSH + 4)
+
+// Clock of the NTT units (FCLK_CLK0 in PS_PL_platform), converts wall time to cycles
+#define NTT_CLK_HZ              80000000u
+
+// --- Types -------------------------------------------------------------------
+typedef struct {
+    u32 Busy;                   // cycles from leaving IDLE to DONE
+    u32 Stage[NTT_PERF_STAGES]; // cycles spent in each butterfly stage, incl. bank swap
+    u32 FlushStall;             // cycles draining the butterfly pipeline
+    u32 InttWaitStall;          // inverse warm-up cycles
+    u32 Issued;                 // butterflies issued
+    u32 BramConflicts;          // cycles the AXI port took BRAM port A from a running job
+    u32 Jobs;                   // completed jobs (1 in the job bank)
+} NttPerf;
+
+// --- Function Prototypes -----------------------------------------------------
+void NttPerf_Read(UINTPTR CtrlBaseAddr, int Bank, NttPerf *Perf);
+void NttPerf_ClearTotals(UINTPTR CtrlBaseAddr);
+
+// Prints where the cycles went. WallCycles is the software-measured time of the same
+// work in NTT clock cycles (0 if unknown); the part not covered by Busy is data movement
+// and driver overhead.
+void NttPerf_Report(const char *Label, const NttPerf *Perf, u64 WallCycles);
+
+#endif
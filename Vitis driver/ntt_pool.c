@@ -0,0 +1,231 @@
+#include <xil_io.h>
+#include <xstatus.h>
+#include "ntt_pool.h"
+
+// Cost model used for least-outstanding-work dispatch, in accelerator cycles:
+// log2(N) stages of N/2 butterflies plus the controller's bank-swap delay per stage,
+// the INTT warm-up state, and one beat per coefficient for each DMA direction,
+// per polynomial, plus the DONE/IDLE turnaround between polynomials of a vector.
+#define NTT_STAGES              8
+#define NTT_BANK_SWAP_CYCLES    4
+#define NTT_INTT_WAIT_CYCLES    2
+#define NTT_POLY_GAP_CYCLES     2
+
+static u32 NttJob_Polys(const NttJob *Job)
+{
+    return Job->Count ? Job->Count : 1;
+}
+
+// -----------------------------------------------------------------------------
+// Job cost estimate
+// -----------------------------------------------------------------------------
+u32 NttPool_JobCost(u32 Mode, u32 Count)
+{
+    u32 Cost = NTT_STAGES * (NTT_COEFF_COUNT / 2 + NTT_BANK_SWAP_CYCLES);
+    Cost += 2 * NTT_COEFF_COUNT;
+    if (Mode == NTT_MODE_INVERSE)
+        Cost += NTT_INTT_WAIT_CYCLES;
+    if (Count > 1)
+        Cost = Count * Cost + (Count - 1) * NTT_POLY_GAP_CYCLES;
+    return Cost;
+}
+
+// -----------------------------------------------------------------------------
+// Pool Setup
+// -----------------------------------------------------------------------------
+int NttPool_Initialize(NttPool *Pool, const NttUnit_Config *ConfigTable, u32 Count,
+                       NttPool_CopyFn Copy, void *CopyRef)
+{
+    u32 i;
+
+    if (!Pool || !ConfigTable || !Copy || Count == 0 || Count > NTT_POOL_MAX_UNITS)
+        return XST_FAILURE;
+
+    Pool->NumUnits = Count;
+    Pool->Copy = Copy;
+    Pool->CopyRef = CopyRef;
+    Pool->CollectPerf = 0;
+
+    for (i = 0; i < Count; i++) {
+        NttUnit *Unit = &Pool->Units[i];
+
+        Unit->Config = ConfigTable[i];
+        Unit->Head = 0;
+        Unit->Count = 0;
+        Unit->Running = 0;
+        Unit->IrqPending = 0;
+        Unit->Outstanding = 0;
+        Unit->JobsCompleted = 0;
+        Unit->Dual = (Xil_In32(Unit->Config.CtrlBaseAddr + NTT_STATUS) & NTT_STATUS_DUAL) != 0;
+
+        // make sure no stale start bit or latched interrupt survives a warm restart
+        Xil_Out32(Unit->Config.CtrlBaseAddr + NTT_AP_CTRL, 0x0);
+        Xil_Out32(Unit->Config.CtrlBaseAddr + NTT_IRQ_CLEAR, 1);
+        Xil_Out32(Unit->Config.CtrlBaseAddr + NTT_IRQ_CLEAR, 0);
+    }
+
+    return XST_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Start the job at the head of an instance's queue
+// -----------------------------------------------------------------------------
+static int NttUnit_StartHead(NttPool *Pool, NttUnit *Unit)
+{
+    NttJob *Job = Unit->Queue[Unit->Head];
+    u32 Polys = NttJob_Polys(Job);
+    int Status;
+
+    // the unit ignores START while a command runs; only another master can get here
+    if (Xil_In32(Unit->Config.CtrlBaseAddr + NTT_STATUS) & NTT_STATUS_BUSY)
+        return XST_DEVICE_BUSY;
+
+    // --- DRAM -> BRAM, banks 0..Polys-1 are contiguous on S01 ---
+    Status = Pool->Copy(Pool->CopyRef, (UINTPTR)Job->Src, Unit->Config.BramBaseAddr,
+                        Polys * NTT_TRANSFER_LEN_BYTES, NTT_COPY_TO_DEVICE);
+    if (Status != XST_SUCCESS)
+        return Status;
+
+    // --- Start NTT, one interrupt after the last polynomial ---
+    Unit->IrqPending = 0;
+    Unit->Running = 1;
+    Xil_Out32(Unit->Config.CtrlBaseAddr + NTT_AP_CTRL,
+              0x01 | (Job->Mode ? 0x02 : 0x0) | (Polys << NTT_CTRL_COUNT_SHIFT) |
+              (Job->Scheme != NTT_SCHEME_PRIMARY ? NTT_CTRL_SCHEME : 0x0));
+    Xil_Out32(Unit->Config.CtrlBaseAddr + NTT_AP_CTRL, 0x0);
+
+    // ERROR is cleared by an accepted start, so it flags this start as lost
+    if (Xil_In32(Unit->Config.CtrlBaseAddr + NTT_STATUS) & NTT_STATUS_ERROR) {
+        Unit->Running = 0;
+        return XST_DEVICE_BUSY;
+    }
+
+    return XST_SUCCESS;
+}
+
+// Removes the head job, reporting Status to its owner
+static void NttUnit_Retire(NttUnit *Unit, int Status)
+{
+    NttJob *Job = Unit->Queue[Unit->Head];
+
+    Unit->Head = (Unit->Head + 1) % NTT_POOL_QUEUE_DEPTH;
+    Unit->Count--;
+    Unit->Running = 0;
+    Unit->Outstanding -= NttPool_JobCost(Job->Mode, NttJob_Polys(Job));
+    Unit->JobsCompleted++;
+
+    Job->Status = Status;
+    Job->Done = 1;
+}
+
+// -----------------------------------------------------------------------------
+// Submit: queue on the instance with the least outstanding work. NTT_SCHEME_ALT
+// jobs only go to dual-mode instances (XST_INVALID_PARAM if the pool has none).
+// -----------------------------------------------------------------------------
+int NttPool_Submit(NttPool *Pool, NttJob *Job)
+{
+    NttUnit *Best = NULL;
+    int Capable = 0;
+    u32 i;
+
+    if (NttJob_Polys(Job) > NTT_POOL_MAX_POLYS)
+        return XST_INVALID_PARAM;
+
+    for (i = 0; i < Pool->NumUnits; i++) {
+        NttUnit *Unit = &Pool->Units[i];
+        // a single-modulus instance ignores SCHEME and would run the job mod NTT_Q
+        if (Job->Scheme != NTT_SCHEME_PRIMARY && !Unit->Dual)
+            continue;
+        Capable = 1;
+        if (Unit->Count == NTT_POOL_QUEUE_DEPTH)
+            continue;
+        if (!Best || Unit->Outstanding < Best->Outstanding)
+            Best = Unit;
+    }
+
+    if (!Capable)
+        return XST_INVALID_PARAM;
+    if (!Best)
+        return XST_FAILURE;    // every queue is full, poll and retry
+
+    Job->Done = 0;
+    Job->Status = XST_SUCCESS;
+    Job->Unit = (int)(Best - Pool->Units);
+
+    Best->Queue[(Best->Head + Best->Count) % NTT_POOL_QUEUE_DEPTH] = Job;
+    Best->Count++;
+    Best->Outstanding += NttPool_JobCost(Job->Mode, NttJob_Polys(Job));
+
+    if (!Best->Running) {
+        int Status = NttUnit_StartHead(Pool, Best);
+        if (Status != XST_SUCCESS)
+            NttUnit_Retire(Best, Status);
+    }
+
+    return XST_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Poll: collect finished instances and start their next queued job.
+// Returns the number of jobs still queued or running across the pool.
+// -----------------------------------------------------------------------------
+int NttPool_Poll(NttPool *Pool)
+{
+    int Remaining = 0;
+    u32 i;
+
+    for (i = 0; i < Pool->NumUnits; i++) {
+        NttUnit *Unit = &Pool->Units[i];
+
+        if (Unit->Running && Unit->IrqPending) {
+            NttJob *Job = Unit->Queue[Unit->Head];
+            int Status;
+
+            Unit->IrqPending = 0;
+
+            // the job bank holds until the next start on this instance
+            if (Pool->CollectPerf)
+                NttPerf_Read(Unit->Config.CtrlBaseAddr, NTT_PERF_BANK_JOB, &Job->Perf);
+
+            // --- BRAM -> DRAM ---
+            Status = Pool->Copy(Pool->CopyRef, Unit->Config.BramBaseAddr, (UINTPTR)Job->Dest,
+                                NttJob_Polys(Job) * NTT_TRANSFER_LEN_BYTES, NTT_COPY_FROM_DEVICE);
+            NttUnit_Retire(Unit, Status);
+        }
+
+        while (!Unit->Running && Unit->Count > 0) {
+            int Status = NttUnit_StartHead(Pool, Unit);
+            if (Status == XST_SUCCESS)
+                break;
+            NttUnit_Retire(Unit, Status);
+        }
+
+        Remaining += Unit->Count;
+    }
+
+    return Remaining;
+}
+
+// -----------------------------------------------------------------------------
+// Wait for one job, servicing the rest of the pool meanwhile
+// -----------------------------------------------------------------------------
+int NttPool_Wait(NttPool *Pool, NttJob *Job)
+{
+    while (!Job->Done)
+        NttPool_Poll(Pool);
+    return Job->Status;
+}
+
+// -----------------------------------------------------------------------------
+// NTT Interrupt Handler, one connection per instance (CallbackRef = NttUnit *)
+// -----------------------------------------------------------------------------
+void NttPool_Isr(void *CallbackRef)
+{
+    NttUnit *Unit = (NttUnit *)CallbackRef;
+
+    // the irq line stays latched until NTT_IRQ_CLEAR is pulsed; the level is a register,
+    // so two back-to-back AXI writes hold it for several PL clocks and nothing blocks here
+    Xil_Out32(Unit->Config.CtrlBaseAddr + NTT_IRQ_CLEAR, 1);
+    Xil_Out32(Unit->Config.CtrlBaseAddr + NTT_IRQ_CLEAR, 0);
+    Unit->IrqPending = 1;
+}
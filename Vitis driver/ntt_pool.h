@@ -0,0 +1,92 @@
+#ifndef NTT_POOL_H
+#define NTT_POOL_H
+
+#include "xil_types.h"
+#include "ntt_perf.h"
+
+// --- Configuration Constants -------------------------------------------------
+#define NTT_POOL_MAX_UNITS      4       // AXI_NTT_UNIT instances handled by one pool
+#define NTT_POOL_QUEUE_DEPTH    8       // jobs queued per instance
+#define NTT_POOL_MAX_POLYS      4       // coefficient banks per instance (vector command)
+#define NTT_COEFF_COUNT         256
+#define NTT_TRANSFER_LEN_BYTES  (NTT_COEFF_COUNT * sizeof(u32))
+
+// NTT Control Offsets (S00_AXI register map)
+#define NTT_AP_CTRL             0x00
+#define NTT_IRQ_CLEAR           0x04    // write: [0] clears the latched interrupt
+#define NTT_STATUS              0x04    // read: status bits below
+#define NTT_STATUS_DONE         0x01    // interrupt latched
+#define NTT_STATUS_BUSY         0x02    // vector command running, START is ignored
+#define NTT_STATUS_ERROR        0x04    // the last START edge was dropped (unit was busy)
+#define NTT_STATUS_DUAL         0x08    // dual-mode build, NTT_CTRL_SCHEME is honoured
+#define NTT_MODE_FORWARD        0
+#define NTT_MODE_INVERSE        1
+#define NTT_CTRL_COUNT_SHIFT    2       // NTT_AP_CTRL[4:2]: polynomials per start
+#define NTT_CTRL_SCHEME         0x20    // NTT_AP_CTRL[5]: second modulus
+#define NTT_SCHEME_PRIMARY      0       // the unit's NTT_Q (Kyber)
+#define NTT_SCHEME_ALT          1       // NTT_Q_ALT of a dual-mode build (Dilithium)
+
+// Data movement directions passed to the copy callback
+#define NTT_COPY_TO_DEVICE      0
+#define NTT_COPY_FROM_DEVICE    1
+
+// --- Types -------------------------------------------------------------------
+
+// One AXI_NTT_UNIT instance as seen from the PS
+typedef struct {
+    UINTPTR CtrlBaseAddr;   // S00_AXI (control/status registers)
+    UINTPTR BramBaseAddr;   // S01_AXI (coefficient memory)
+    u32     IrqId;          // GIC interrupt ID of the instance's irq line
+} NttUnit_Config;
+
+// Moves Len bytes between DDR and an instance's coefficient memory (CDMA on target)
+typedef int (*NttPool_CopyFn)(void *CopyRef, UINTPTR Src, UINTPTR Dest, u32 Len, int Direction);
+
+// A job transforms Count polynomials stored back to back (a polyvec): one copy per
+// direction and one interrupt for the whole vector, polynomial i in BRAM bank i.
+typedef struct {
+    u32 *Src;               // Count * NTT_COEFF_COUNT input coefficients
+    u32 *Dest;              // Count * NTT_COEFF_COUNT output coefficients
+    u32 Mode;               // NTT_MODE_FORWARD / NTT_MODE_INVERSE
+    u32 Count;              // polynomials, 1..NTT_POOL_MAX_POLYS (0 is taken as 1)
+    u32 Scheme;             // NTT_SCHEME_PRIMARY / NTT_SCHEME_ALT (dual-mode instances only)
+    volatile int Done;      // set once Dest holds the result
+    int Status;             // XST_SUCCESS, the failing copy status or XST_DEVICE_BUSY
+    int Unit;               // instance the job was dispatched to
+    NttPerf Perf;           // hardware counters of this job (NttPool.CollectPerf)
+} NttJob;
+
+typedef struct {
+    NttUnit_Config Config;
+    NttJob *Queue[NTT_POOL_QUEUE_DEPTH];
+    u32 Head;
+    u32 Count;              // queued jobs, including the running one
+    int Running;            // Queue[Head] is executing on the hardware
+    volatile int IrqPending;// set by NttPool_Isr, consumed by NttPool_Poll
+    u32 Outstanding;        // estimated cycles of queued + running work
+    u32 JobsCompleted;
+    int Dual;               // NTT_STATUS_DUAL read at initialization
+} NttUnit;
+
+typedef struct {
+    NttUnit Units[NTT_POOL_MAX_UNITS];
+    u32 NumUnits;
+    NttPool_CopyFn Copy;
+    void *CopyRef;
+    int CollectPerf;        // snapshot the job counters into NttJob.Perf on completion
+} NttPool;
+
+// Instances found in xparameters.h (ntt_pool_g.c)
+extern const NttUnit_Config NttUnit_ConfigTable[];
+extern const u32 NttUnit_ConfigCount;
+
+// --- Function Prototypes -----------------------------------------------------
+int NttPool_Initialize(NttPool *Pool, const NttUnit_Config *ConfigTable, u32 Count,
+                       NttPool_CopyFn Copy, void *CopyRef);
+u32 NttPool_JobCost(u32 Mode, u32 Count);
+int NttPool_Submit(NttPool *Pool, NttJob *Job);
+int NttPool_Poll(NttPool *Pool);
+int NttPool_Wait(NttPool *Pool, NttJob *Job);
+void NttPool_Isr(void *CallbackRef);
+
+#endif
@@ -0,0 +1,35 @@
+#include "xparameters.h"
+#include "ntt_pool.h"
+
+// AXI_NTT_UNIT instances present in the block design.
+// Further instances are picked up automatically once they exist in xparameters.h.
+const NttUnit_Config NttUnit_ConfigTable[] = {
+    {
+        XPAR_AXI_NTT_UNIT_0_S00_AXI_BASEADDR,
+        XPAR_AXI_NTT_UNIT_0_S01_AXI_BASEADDR,
+        XPAR_FABRIC_AXI_NTT_UNIT_0_VEC_ID
+    },
+#ifdef XPAR_AXI_NTT_UNIT_1_S00_AXI_BASEADDR
+    {
+        XPAR_AXI_NTT_UNIT_1_S00_AXI_BASEADDR,
+        XPAR_AXI_NTT_UNIT_1_S01_AXI_BASEADDR,
+        XPAR_FABRIC_AXI_NTT_UNIT_1_VEC_ID
+    },
+#endif
+#ifdef XPAR_AXI_NTT_UNIT_2_S00_AXI_BASEADDR
+    {
+        XPAR_AXI_NTT_UNIT_2_S00_AXI_BASEADDR,
+        XPAR_AXI_NTT_UNIT_2_S01_AXI_BASEADDR,
+        XPAR_FABRIC_AXI_NTT_UNIT_2_VEC_ID
+    },
+#endif
+#ifdef XPAR_AXI_NTT_UNIT_3_S00_AXI_BASEADDR
+    {
+        XPAR_AXI_NTT_UNIT_3_S00_AXI_BASEADDR,
+        XPAR_AXI_NTT_UNIT_3_S01_AXI_BASEADDR,
+        XPAR_FABRIC_AXI_NTT_UNIT_3_VEC_ID
+    },
+#endif
+};
+
+const u32 NttUnit_ConfigCount = sizeof(NttUnit_ConfigTable) / sizeof(NttUnit_ConfigTable[0]);
@@ -0,0 +1,8 @@
+#ifndef XIL_PRINTF_H
+#define XIL_PRINTF_H
+
+// host build stand-in
+#include <stdio.h>
+#define xil_printf printf
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef XIL_TYPES_H
+#define XIL_TYPES_H
+
+// host build stand-in for the standalone BSP header
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint8_t   u8;
+typedef uint16_t  u16;
+typedef uint32_t  u32;
+typedef uint64_t  u64;
+typedef uintptr_t UINTPTR;
+
+#endif
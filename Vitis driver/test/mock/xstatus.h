@@ -0,0 +1,9 @@
+#ifndef XSTATUS_H
+#define XSTATUS_H
+
+#define XST_SUCCESS 0L
+#define XST_FAILURE 1L
+#define XST_INVALID_PARAM 15L
+#define XST_DEVICE_BUSY 21L
+
+#endif
@@ -0,0 +1,462 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "xil_io.h"
+#include "xstatus.h"
+#include "ntt_pool.h"
+
+// Host test of the multi-instance NttPool against in-process mock AXI_NTT_UNITs.
+// A mock follows the S00_AXI protocol: rising edge of NTT_AP_CTRL[0] starts a job
+// (mode in bit 1, polynomial count in bits 4:2), completion of the last polynomial
+// latches irq until NTT_IRQ_CLEAR[0] is written. A start while busy is dropped and
+// reported in the ERROR status bit, as in NTT_AXI_wrapper.
+// The "transform" adds 1 (forward) or subtracts 1 (inverse) mod Q, so results
+// show which direction ran and that every coefficient made the round trip.
+// Performance counters follow NTT_perf_counters: the job bank counts busy ticks and
+// restarts on every start, the total bank runs until NTT_PERF_CLEAR is written.
+
+#define Q               3329
+#define MAX_MOCKS       NTT_POOL_MAX_UNITS
+#define MOCK_CTRL_BASE  0x43C00000u
+#define MOCK_BRAM_BASE  0x40000000u
+#define MOCK_STRIDE     0x10000u
+
+typedef struct {
+    UINTPTR CtrlBase;
+    UINTPTR BramBase;
+    u32 Ctrl;
+    u32 Mem[NTT_POOL_MAX_POLYS * NTT_COEFF_COUNT];
+    int Busy, Countdown, Mode, Polys, Irq, Dropped;
+    int Dual, Scheme;           // dual-mode build, modulus of the running job
+    int Latency;                // ticks per job
+    int Starts, ProtocolErrors;
+    u32 PerfCtrl;
+    u32 JobBusy, TotalBusy, TotalJobs;
+} MockDev;
+
+static MockDev Mocks[MAX_MOCKS];
+static int NumMocks;
+static int MockDualMask;        // bit i: Setup builds instance i as dual-mode
+static NttPool Pool;
+
+// --- Mock register bus ---------------------------------------------------------
+static MockDev *Mock_Find(UINTPTR Addr, int *IsBram, u32 *Offset)
+{
+    for (int i = 0; i < NumMocks; i++) {
+        MockDev *Dev = &Mocks[i];
+        if (Addr >= Dev->CtrlBase && Addr < Dev->CtrlBase + 16) {
+            *IsBram = 0;
+            *Offset = (u32)(Addr - Dev->CtrlBase);
+            return Dev;
+        }
+        if (Addr >= Dev->BramBase && Addr < Dev->BramBase + sizeof(Dev->Mem)) {
+            *IsBram = 1;
+            *Offset = (u32)(Addr - Dev->BramBase);
+            return Dev;
+        }
+    }
+    return NULL;
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+    int IsBram;
+    u32 Offset;
+    MockDev *Dev = Mock_Find(Addr, &IsBram, &Offset);
+
+    if (!Dev) {
+        printf("write to unmapped address 0x%lx\n", (unsigned long)Addr);
+        return;
+    }
+
+    if (IsBram) {
+        if (Dev->Busy) Dev->ProtocolErrors++;   // DMA into a running instance
+        Dev->Mem[Offset / 4] = Value;
+        return;
+    }
+
+    if (Offset == NTT_AP_CTRL) {
+        if ((Value & 1) && !(Dev->Ctrl & 1) && Dev->Busy) {
+            Dev->Dropped = 1;
+            Dev->ProtocolErrors++;
+        } else if ((Value & 1) && !(Dev->Ctrl & 1)) {
+            if (Dev->Irq) Dev->ProtocolErrors++;
+            Dev->Dropped = 0;
+            Dev->Busy = 1;
+            Dev->Countdown = Dev->Latency;
+            Dev->Mode = (Value >> 1) & 1;
+            Dev->Scheme = Dev->Dual && (Value & NTT_CTRL_SCHEME);
+            if ((Value & NTT_CTRL_SCHEME) && !Dev->Dual) Dev->ProtocolErrors++;
+            Dev->Polys = (Value >> NTT_CTRL_COUNT_SHIFT) & 7;
+            if (Dev->Polys == 0) Dev->Polys = 1;
+            if (Dev->Polys > NTT_POOL_MAX_POLYS) Dev->ProtocolErrors++;
+            Dev->Countdown = Dev->Latency * Dev->Polys;
+            Dev->JobBusy = 0;
+            Dev->Starts++;
+        }
+        Dev->Ctrl = Value;
+    } else if (Offset == NTT_IRQ_CLEAR) {
+        if (Value & 1) Dev->Irq = 0;
+    } else if (Offset == NTT_PERF_CTRL) {
+        Dev->PerfCtrl = Value;
+        if (Value & NTT_PERF_CLEAR) Dev->TotalBusy = Dev->TotalJobs = 0;
+    }
+}
+
+static u32 Mock_PerfData(MockDev *Dev)
+{
+    int Total = (Dev->PerfCtrl & NTT_PERF_SEL_TOTAL) != 0;
+    switch (Dev->PerfCtrl & 0xF) {
+    case NTT_PERF_BUSY:  return Total ? Dev->TotalBusy : Dev->JobBusy;
+    case NTT_PERF_ISSUE: return Total ? 1024 * Dev->TotalJobs : 1024 * (u32)Dev->Polys;
+    case NTT_PERF_JOBS:  return Total ? Dev->TotalJobs : !Dev->Busy;
+    default:             return 0;
+    }
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+    int IsBram;
+    u32 Offset;
+    MockDev *Dev = Mock_Find(Addr, &IsBram, &Offset);
+
+    if (!Dev) return 0;
+    if (IsBram) {
+        if (Dev->Busy) Dev->ProtocolErrors++;   // DMA out of a running instance
+        return Dev->Mem[Offset / 4];
+    }
+    if (Offset == NTT_AP_CTRL) return Dev->Ctrl;
+    if (Offset == NTT_PERF_CTRL) return Dev->PerfCtrl;
+    if (Offset == NTT_PERF_DATA) return Mock_PerfData(Dev);
+    return (u32)(Dev->Irq | (Dev->Busy << 1) | (Dev->Dropped << 2) | (Dev->Dual << 3));
+}
+
+// word-by-word copy through the mock bus, standing in for the CDMA
+static int Mock_Copy(void *CopyRef, UINTPTR Src, UINTPTR Dest, u32 Len, int Direction)
+{
+    (void)CopyRef;
+    for (u32 i = 0; i < Len / 4; i++) {
+        if (Direction == NTT_COPY_TO_DEVICE)
+            Xil_Out32(Dest + 4 * i, ((u32 *)Src)[i]);
+        else
+            ((u32 *)Dest)[i] = Xil_In32(Src + 4 * i);
+    }
+    return XST_SUCCESS;
+}
+
+// advances every mock by one tick, then delivers level-sensitive interrupts like the GIC
+static void Mock_Tick(void)
+{
+    for (int i = 0; i < NumMocks; i++) {
+        MockDev *Dev = &Mocks[i];
+        if (Dev->Busy) {
+            Dev->JobBusy++;
+            Dev->TotalBusy++;
+        }
+        if (Dev->Busy && --Dev->Countdown == 0) {
+            Dev->TotalJobs++;
+            // stand-in transforms: +-1 mod Q, +-2 for the second modulus
+            for (int k = 0; k < Dev->Polys * NTT_COEFF_COUNT; k++)
+                Dev->Mem[k] = Dev->Mode ? (Dev->Mem[k] + Q - 1 - Dev->Scheme) % Q
+                                        : (Dev->Mem[k] + 1 + Dev->Scheme) % Q;
+            Dev->Busy = 0;
+            Dev->Irq = 1;
+        }
+    }
+    for (int i = 0; i < NumMocks; i++) {
+        if (Mocks[i].Irq) NttPool_Isr(&Pool.Units[i]);
+    }
+}
+
+static int Setup(int Count, const int *Latency)
+{
+    NttUnit_Config Table[MAX_MOCKS];
+
+    memset(Mocks, 0, sizeof(Mocks));
+    NumMocks = Count;
+    for (int i = 0; i < Count; i++) {
+        Mocks[i].CtrlBase = MOCK_CTRL_BASE + i * MOCK_STRIDE;
+        Mocks[i].BramBase = MOCK_BRAM_BASE + i * MOCK_STRIDE;
+        Mocks[i].Latency = Latency[i];
+        Mocks[i].Dual = (MockDualMask >> i) & 1;
+        Table[i].CtrlBaseAddr = Mocks[i].CtrlBase;
+        Table[i].BramBaseAddr = Mocks[i].BramBase;
+        Table[i].IrqId = 61 + i;
+    }
+    return NttPool_Initialize(&Pool, Table, Count, Mock_Copy, NULL);
+}
+
+// --- Scenarios -------------------------------------------------------------------
+#define MAX_JOBS 96
+
+static u32 Src[MAX_JOBS][NTT_COEFF_COUNT];
+static u32 Dst[MAX_JOBS][NTT_COEFF_COUNT];
+static NttJob Jobs[MAX_JOBS];
+
+// submits NumJobs jobs, one every ArrivalGap ticks (0 = as fast as queues allow)
+static int Run_Jobs(int NumJobs, int ArrivalGap, int *JobsPerUnit)
+{
+    int Submitted = 0, Errors = 0, Ticks = 0;
+
+    for (int j = 0; j < NumJobs; j++) {
+        for (int k = 0; k < NTT_COEFF_COUNT; k++) Src[j][k] = (u32)((j * 31 + k) % Q);
+        memset(Dst[j], 0, sizeof(Dst[j]));
+        Jobs[j].Src = Src[j];
+        Jobs[j].Dest = Dst[j];
+        Jobs[j].Mode = (j % 3 == 2) ? NTT_MODE_INVERSE : NTT_MODE_FORWARD;
+        Jobs[j].Count = 1;
+    }
+
+    while (Submitted < NumJobs || NttPool_Poll(&Pool) > 0) {
+        if (Submitted < NumJobs && (ArrivalGap == 0 || Ticks % ArrivalGap == 0)) {
+            if (NttPool_Submit(&Pool, &Jobs[Submitted]) == XST_SUCCESS) Submitted++;
+        }
+        Mock_Tick();
+        NttPool_Poll(&Pool);
+        if (++Ticks > 10000000) {
+            printf("timeout\n");
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < NumMocks; i++) JobsPerUnit[i] = 0;
+
+    for (int j = 0; j < NumJobs; j++) {
+        if (!Jobs[j].Done || Jobs[j].Status != XST_SUCCESS) {
+            printf("job %d not completed\n", j);
+            Errors++;
+            continue;
+        }
+        JobsPerUnit[Jobs[j].Unit]++;
+        for (int k = 0; k < NTT_COEFF_COUNT; k++) {
+            u32 Expected = Jobs[j].Mode ? (Src[j][k] + Q - 1) % Q : (Src[j][k] + 1) % Q;
+            if (Dst[j][k] != Expected) {
+                printf("job %d coeff %d: got %u expected %u\n", j, k, Dst[j][k], Expected);
+                Errors++;
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < NumMocks; i++) {
+        if (Mocks[i].ProtocolErrors) {
+            printf("instance %d: %d protocol violations\n", i, Mocks[i].ProtocolErrors);
+            Errors++;
+        }
+        if (Mocks[i].Starts != JobsPerUnit[i] || (int)Pool.Units[i].JobsCompleted != JobsPerUnit[i]) {
+            printf("instance %d: %d starts, %u completions, %d jobs\n", i, Mocks[i].Starts,
+                   Pool.Units[i].JobsCompleted, JobsPerUnit[i]);
+            Errors++;
+        }
+        if (Pool.Units[i].Outstanding != 0 || Pool.Units[i].Count != 0) {
+            printf("instance %d: work left after drain\n", i);
+            Errors++;
+        }
+    }
+
+    return Errors;
+}
+
+int main(void)
+{
+    int Errors = 0, PerUnit[MAX_MOCKS];
+
+    // 1) single instance, legacy behaviour
+    {
+        const int Lat[] = {500};
+        Setup(1, Lat);
+        Errors += Run_Jobs(12, 0, PerUnit);
+        printf("1 instance:             %d jobs\n", PerUnit[0]);
+    }
+
+    // 2) identical instances share a burst evenly
+    {
+        const int Lat[] = {500, 500, 500};
+        Setup(3, Lat);
+        Errors += Run_Jobs(48, 0, PerUnit);
+        printf("3 equal instances:      %d / %d / %d jobs\n", PerUnit[0], PerUnit[1], PerUnit[2]);
+        // burst of mixed modes: costs differ by a few cycles only
+        for (int i = 0; i < 3; i++) {
+            if (PerUnit[i] < 15 || PerUnit[i] > 17) {
+                printf("ERROR: unbalanced distribution\n");
+                Errors++;
+                break;
+            }
+        }
+    }
+
+    // 3) a slow instance receives less work under steady arrivals
+    {
+        const int Lat[] = {400, 400, 1600, 400};
+        Setup(4, Lat);
+        Errors += Run_Jobs(MAX_JOBS, 150, PerUnit);
+        printf("fast/fast/slow/fast:    %d / %d / %d / %d jobs\n",
+               PerUnit[0], PerUnit[1], PerUnit[2], PerUnit[3]);
+        if (PerUnit[2] >= PerUnit[0] || PerUnit[2] >= PerUnit[1] || PerUnit[2] >= PerUnit[3]) {
+            printf("ERROR: slow instance was not avoided\n");
+            Errors++;
+        }
+    }
+
+    // 4) back-pressure once every queue is full
+    {
+        const int Lat[] = {1000, 1000};
+        int Accepted = 0;
+        Setup(2, Lat);
+        for (int j = 0; j < MAX_JOBS; j++) {
+            Jobs[j].Src = Src[j];
+            Jobs[j].Dest = Dst[j];
+            Jobs[j].Mode = NTT_MODE_FORWARD;
+            Jobs[j].Count = 1;
+            if (NttPool_Submit(&Pool, &Jobs[j]) == XST_SUCCESS) Accepted++;
+        }
+        printf("queue capacity:         %d jobs accepted\n", Accepted);
+        if (Accepted != 2 * NTT_POOL_QUEUE_DEPTH) {
+            printf("ERROR: expected %d accepted jobs\n", 2 * NTT_POOL_QUEUE_DEPTH);
+            Errors++;
+        }
+        while (NttPool_Poll(&Pool) > 0) Mock_Tick();
+    }
+
+    // 5) per-job counter snapshots and the free-running bank
+    {
+        const int Lat[] = {300, 700};
+        u32 BusySum = 0;
+        NttPerf Totals[2];
+        Setup(2, Lat);
+        Pool.CollectPerf = 1;
+        for (int i = 0; i < 2; i++) NttPerf_ClearTotals(Mocks[i].CtrlBase);
+        Errors += Run_Jobs(16, 0, PerUnit);
+        for (int j = 0; j < 16; j++) {
+            u32 Expected = (u32)Lat[Jobs[j].Unit];
+            if (Jobs[j].Perf.Busy != Expected || Jobs[j].Perf.Jobs != 1 || Jobs[j].Perf.Issued != 1024) {
+                printf("job %d: busy %u (expected %u), jobs %u, issued %u\n", j, Jobs[j].Perf.Busy,
+                       Expected, Jobs[j].Perf.Jobs, Jobs[j].Perf.Issued);
+                Errors++;
+            }
+            BusySum += Jobs[j].Perf.Busy;
+        }
+        for (int i = 0; i < 2; i++) NttPerf_Read(Mocks[i].CtrlBase, NTT_PERF_BANK_TOTAL, &Totals[i]);
+        printf("perf snapshots:         %u + %u busy cycles, %u + %u jobs\n",
+               Totals[0].Busy, Totals[1].Busy, Totals[0].Jobs, Totals[1].Jobs);
+        if (Totals[0].Busy + Totals[1].Busy != BusySum || Totals[0].Jobs + Totals[1].Jobs != 16) {
+            printf("ERROR: free-running counters do not match the job snapshots\n");
+            Errors++;
+        }
+        NttPerf_Report("instance 0", &Totals[0], 0);
+    }
+
+    // 6) vector jobs: one start, one interrupt and one copy per direction per vector
+    {
+        static u32 Vec[24][NTT_POOL_MAX_POLYS * NTT_COEFF_COUNT];
+        const int Lat[] = {300, 300};
+        int Ticks = 0, Polys = 0, Starts;
+        NttJob Bad = {0};
+
+        Setup(2, Lat);
+        for (int j = 0; j < 24; j++) {
+            Jobs[j].Count = 1 + j % NTT_POOL_MAX_POLYS;
+            for (u32 k = 0; k < Jobs[j].Count * NTT_COEFF_COUNT; k++)
+                Vec[j][k] = (u32)((j * 17 + k) % Q);
+            Jobs[j].Src = Jobs[j].Dest = Vec[j];
+            Jobs[j].Mode = NTT_MODE_FORWARD;
+            Polys += Jobs[j].Count;
+        }
+        for (int j = 0; j < 24;) {
+            if (NttPool_Submit(&Pool, &Jobs[j]) == XST_SUCCESS) j++;
+            else { Mock_Tick(); NttPool_Poll(&Pool); Ticks++; }
+        }
+        while (NttPool_Poll(&Pool) > 0 && Ticks++ < 1000000) Mock_Tick();
+
+        Starts = Mocks[0].Starts + Mocks[1].Starts;
+        printf("vector jobs:            %d polynomials in %d starts, %d ticks\n", Polys, Starts, Ticks);
+        if (Starts != 24 || Mocks[0].ProtocolErrors || Mocks[1].ProtocolErrors) {
+            printf("ERROR: expected one start per vector\n");
+            Errors++;
+        }
+        for (int j = 0; j < 24; j++) {
+            for (u32 k = 0; k < Jobs[j].Count * NTT_COEFF_COUNT; k++) {
+                if (!Jobs[j].Done || Vec[j][k] != (u32)((j * 17 + k + 1) % Q)) {
+                    printf("vector job %d coeff %u wrong\n", j, k);
+                    Errors++;
+                    break;
+                }
+            }
+        }
+
+        Bad.Count = NTT_POOL_MAX_POLYS + 1;
+        if (NttPool_Submit(&Pool, &Bad) != XST_INVALID_PARAM) {
+            printf("ERROR: oversized vector accepted\n");
+            Errors++;
+        }
+    }
+
+    // 7) an instance started by someone else is reported busy, not overwritten
+    {
+        const int Lat[] = {300};
+        NttJob Job = {0};
+        int Refused;
+        Setup(1, Lat);
+        Job.Src = Job.Dest = Src[0];
+        Job.Count = 1;
+        Xil_Out32(Mocks[0].CtrlBase + NTT_AP_CTRL, 0x01);   // foreign start
+        Xil_Out32(Mocks[0].CtrlBase + NTT_AP_CTRL, 0x00);
+        if (NttPool_Submit(&Pool, &Job) != XST_SUCCESS || !Job.Done || Job.Status != XST_DEVICE_BUSY ||
+            Mocks[0].ProtocolErrors) {
+            printf("ERROR: job on a busy instance: done %d, status %d, %d protocol violations\n",
+                   Job.Done, Job.Status, Mocks[0].ProtocolErrors);
+            Errors++;
+        }
+        Refused = Job.Status;
+        while (Mocks[0].Busy) Mock_Tick();
+        Mocks[0].Irq = 0;
+        if (NttPool_Submit(&Pool, &Job) != XST_SUCCESS) Errors++;
+        while (NttPool_Poll(&Pool) > 0) Mock_Tick();
+        printf("busy instance:          status %d, then %d after it went idle\n", Refused, Job.Status);
+        if (Job.Status != XST_SUCCESS) {
+            printf("ERROR: job not run once the instance was idle\n");
+            Errors++;
+        }
+    }
+
+    // 8) second-modulus jobs only run on dual-mode instances
+    {
+        const int Lat[] = {100, 100};
+        NttJob Alt = {0}, Primary = {0};
+        int AltErrors = 0;
+
+        MockDualMask = 0x2;
+        Setup(2, Lat);
+        MockDualMask = 0;
+        for (int k = 0; k < NTT_COEFF_COUNT; k++) Src[0][k] = Src[1][k] = (u32)k;
+        Alt.Src = Alt.Dest = Src[0];
+        Alt.Count = 1;
+        Alt.Scheme = NTT_SCHEME_ALT;
+        Primary.Src = Primary.Dest = Src[1];
+        Primary.Count = 1;
+        // the idle single-mode instance 0 would win on load, the scheme rules it out
+        if (NttPool_Submit(&Pool, &Alt) != XST_SUCCESS || Alt.Unit != 1) AltErrors++;
+        if (NttPool_Submit(&Pool, &Primary) != XST_SUCCESS || Primary.Unit != 0) AltErrors++;
+        while (NttPool_Poll(&Pool) > 0) Mock_Tick();
+        for (int k = 0; k < NTT_COEFF_COUNT; k++)
+            if (Src[0][k] != (u32)(k + 2) % Q || Src[1][k] != (u32)(k + 1) % Q) AltErrors++;
+        if (Alt.Status != XST_SUCCESS || Primary.Status != XST_SUCCESS ||
+            Mocks[0].ProtocolErrors || Mocks[1].ProtocolErrors) AltErrors++;
+
+        Setup(1, Lat);
+        if (NttPool_Submit(&Pool, &Alt) != XST_INVALID_PARAM || Mocks[0].Starts != 0) AltErrors++;
+
+        printf("dual-mode dispatch:     %s\n", AltErrors ? "FAILED" : "second modulus on the dual instance only");
+        if (AltErrors) {
+            printf("ERROR: %d dual-mode dispatch failures\n", AltErrors);
+            Errors += AltErrors;
+        }
+    }
+
+    if (Errors) {
+        printf("\nERROR: %d failures\n", Errors);
+        return 1;
+    }
+    printf("\nall NttPool tests passed\n");
+    return 0;
+}
@@ -0,0 +1,44 @@
+#!/bin/sh
+# The packaged IP (ip_repo/AXI_NTT_unit/AXI_NTT_UNIT_1.0/src) carries copies of the
+# RTL in source/. Vivado builds the block design from the copies, so every change
+# to source/ has to land in the IP in the same commit.
+#
+#   ./check_ip.sh          list copies that differ from source/, exit 1 if any
+#   ./check_ip.sh --sync   overwrite the copies with source/
+#
+# Files included by a copy (`include "...") are checked as well, so generated
+# headers cannot go missing from the IP.
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+SRC="$HERE/source"
+IP="$HERE/ip_repo/AXI_NTT_unit/AXI_NTT_UNIT_1.0/src"
+
+SYNC=0
+[ "$1" = "--sync" ] && SYNC=1
+
+FILES=$(cd "$IP" && ls)
+# includes of either version, so a sync also brings in a header the new source needs
+INCLUDES=$(for f in $FILES; do cat "$IP/$f" "$SRC/$f" 2>/dev/null; done |
+           sed -n 's/^[[:space:]]*`include[[:space:]]*"\([^"]*\)".*/\1/p' | sort -u)
+
+STATUS=0
+for f in $(printf '%s\n' $FILES $INCLUDES | sort -u); do
+    if [ ! -f "$SRC/$f" ]; then
+        echo "$f: not in source/"
+        STATUS=1
+    elif [ ! -f "$IP/$f" ] && [ $SYNC -eq 0 ]; then
+        echo "$f: missing from the IP"
+        STATUS=1
+    elif ! cmp -s "$SRC/$f" "$IP/$f"; then
+        if [ $SYNC -eq 1 ]; then
+            cp "$SRC/$f" "$IP/$f"
+            echo "$f: updated"
+        else
+            echo "$f: IP copy differs from source/"
+            STATUS=1
+        fi
+    fi
+done
+
+[ $STATUS -eq 0 ] && [ $SYNC -eq 0 ] && echo "IP sources in sync"
+exit $STATUS
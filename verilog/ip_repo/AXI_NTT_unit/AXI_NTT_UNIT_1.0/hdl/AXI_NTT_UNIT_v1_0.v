@@ -14,12 +14,27 @@ module AXI_NTT_UNIT_v1_0 #
 
     parameter integer C_S01_AXI_ID_WIDTH = 1,
     parameter integer C_S01_AXI_DATA_WIDTH = 32,
-    parameter integer C_S01_AXI_ADDR_WIDTH = 10, // 1024 bytes = 2^10
+    parameter integer C_S01_AXI_ADDR_WIDTH = 12, // 4 banks x 1024 bytes = 2^12
     parameter integer C_S01_AXI_AWUSER_WIDTH = 0,
     parameter integer C_S01_AXI_ARUSER_WIDTH = 0,
     parameter integer C_S01_AXI_WUSER_WIDTH = 0,
     parameter integer C_S01_AXI_RUSER_WIDTH = 0,
-    parameter integer C_S01_AXI_BUSER_WIDTH = 0
+    parameter integer C_S01_AXI_BUSER_WIDTH = 0,
+
+    // NTT datapath (NTT_AXI_wrapper). Kyber only by default; a dual-mode build sets
+    // NTT_Q_ALT/NTT_OMEGA_ALT (Dilithium: 8380417 / 3602218) with NTT_DATA_WIDTH = 23,
+    // then slv_reg0[5] picks the modulus per command and slv_reg1[3] reads back 1.
+    parameter integer NTT_DATA_WIDTH = 12,
+    parameter integer NTT_Q = 3329,
+    parameter integer NTT_OMEGA = 910,
+    parameter integer NTT_Q_ALT = 0,
+    parameter integer NTT_OMEGA_ALT = 0,
+
+    // Butterfly multiplier (Mod_mul): SHIFT_ADD, BARRETT, MONTGOMERY, BOOTH (Kyber only) or
+    // GENERIC, and its pipeline depth, which is also the controller's write-back delay.
+    // synth/Mod_mul_sweep.tcl reports area and Fmax of each choice.
+    parameter MUL_IMPL = "SHIFT_ADD",
+    parameter integer MUL_LATENCY = 3
 )
 (
     // AXI Lite Clock and Reset (Used as main clock for Core)
@@ -110,10 +125,18 @@ module AXI_NTT_UNIT_v1_0 #
     // Outputs to the NTT Core (Control Signals)
     wire ntt_start_o;   // Bit 0 of slv_reg0: Start the operation (typically edge-triggered in core)
     wire ntt_mode_o;    // Bit 1 of slv_reg0: 0=NTT, 1=iNTT
+    wire [2:0] ntt_count_o; // Bits 4:2 of slv_reg0: polynomials per start
+    wire ntt_scheme_o;  // Bit 5 of slv_reg0: second modulus (dual-mode builds)
 
     // Inputs from the NTT Core (Status Signals)
-    wire ntt_int_i;      // NTT done interrupt latch (for slv_reg1[1])
-    wire ntt_error_i;     // Error status (for slv_reg1[2])
+    wire ntt_int_i;      // NTT done interrupt clear (slv_reg1[0] write)
+    wire core_busy_o;    // vector command running (slv_reg1[1] read)
+    wire ntt_error_i;    // start dropped while busy (slv_reg1[2] read)
+
+    // Performance counters (slv_reg2 select/clear, slv_reg3 data)
+    wire [4:0] perf_sel;
+    wire perf_clear;
+    wire [31:0] perf_data;
 
     // Map control signals from the AXI-Lite registers (slv_reg0_o driven by AXI module)
     // Assumption: slv_reg0[0] is START, slv_reg0[1] is MODE
@@ -151,12 +174,12 @@ module AXI_NTT_UNIT_v1_0 #
     // CORRECTED: These are now declared as 'wire' as they are simply connecting two modules.
     // Signals driven by S01_AXI (outputs)
     wire [C_S01_AXI_ADDR_WIDTH-1:0] data_bram_addr_o; // Address from AXI handler to Core/BRAM
-    wire [11:0] data_bram_din_o; // Data to write from AXI handler to Core/BRAM
+    wire [NTT_DATA_WIDTH-1:0] data_bram_din_o; // Data to write from AXI handler to Core/BRAM
     wire data_bram_we_o;         // Write Enable from AXI handler to Core/BRAM
     wire data_bram_en_o;         // Enable from AXI handler to Core/BRAM
 
     // Signal driven by NTT_CORE/BRAM (input to S01_AXI)
-    wire [11:0] data_bram_dout_i; // Read data from Core/BRAM back to AXI handler
+    wire [NTT_DATA_WIDTH-1:0] data_bram_dout_i; // Read data from Core/BRAM back to AXI handler
 
 
 // Instantiation of Axi Slave Bus Interface S00_AXI (Control)
@@ -189,13 +212,22 @@ AXI_NTT_UNIT_v1_0_S00_AXI # (
     // User logic connections (Control/Status)
     .ntt_start_o(ntt_start_o),
     .ntt_mode_o(ntt_mode_o),
+    .ntt_count_o(ntt_count_o),
+    .ntt_scheme_o(ntt_scheme_o),
     .ntt_int_clear(ntt_int_i),
-    .ntt_error_i(ntt_error_i)
+    .ntt_done_i(irq_latched),
+    .ntt_busy_i(core_busy_o),
+    .ntt_error_i(ntt_error_i),
+    .ntt_dual_i(NTT_Q_ALT != 0),
+    .perf_sel_o(perf_sel),
+    .perf_clear_o(perf_clear),
+    .perf_data_i(perf_data)
 );
 
 
 // Instantiation of Axi Bus Interface S01_AXI (Data)
 AXI_NTT_UNIT_v1_0_S01_AXI # ( 
+    .C_COEF_WIDTH(NTT_DATA_WIDTH),
     .C_S_AXI_ID_WIDTH(C_S01_AXI_ID_WIDTH),
     .C_S_AXI_DATA_WIDTH(C_S01_AXI_DATA_WIDTH),
     .C_S_AXI_ADDR_WIDTH(C_S01_AXI_ADDR_WIDTH),
@@ -265,12 +297,22 @@ AXI_NTT_UNIT_v1_0_S01_AXI # (
 // The Core must provide the BRAM functionality, receiving commands from
 // the S01_AXI handler and signaling done/IRQ.
 // =====================================================================
-wire  [7:0] ntt_core_axi_bram_addr;
+// word address: [9:8] = polynomial bank, [7:0] = coefficient
+wire  [C_S01_AXI_ADDR_WIDTH-3:0] ntt_core_axi_bram_addr;
 assign ntt_core_axi_bram_addr = (data_bram_en_o & ~data_bram_we_o) ? (data_bram_addr_o >> 2) +1'b1 : (data_bram_addr_o >> 2) ;
 
 
 // Note: Renamed to NTT_CORE for clarity in the top-level AXI wrapper.
-NTT_AXI_wrapper NTT_CORE (
+NTT_AXI_wrapper #(
+    .MAX_POLYS(2 ** (C_S01_AXI_ADDR_WIDTH - 10)),
+    .DATA_WIDTH(NTT_DATA_WIDTH),
+    .Q(NTT_Q),
+    .OMEGA(NTT_OMEGA),
+    .Q_ALT(NTT_Q_ALT),
+    .OMEGA_ALT(NTT_OMEGA_ALT),
+    .MUL_IMPL(MUL_IMPL),
+    .MUL_LATENCY(MUL_LATENCY)
+) NTT_CORE (
     // Clock and Reset
     .clk(s00_axi_aclk),
     .rst(~s00_axi_aresetn), // Use inverted reset if core is active-high
@@ -278,7 +320,11 @@ NTT_AXI_wrapper NTT_CORE (
     // Control Signals (from S00_AXI Lite)
     .start(core_start_i),
     .mode(core_mode_i),
+    .scheme(ntt_scheme_o),  // ignored unless NTT_Q_ALT != 0
+    .count(ntt_count_o),
     .done(core_done_o),
+    .busy(core_busy_o),
+    .start_dropped(ntt_error_i),
     .irq(core_irq_o),
     
     // Data Signals (from S01_AXI Full, connected to BRAM access)
@@ -287,7 +333,12 @@ NTT_AXI_wrapper NTT_CORE (
     .axi_bram_din(data_bram_din_o),   // Input to Core
     .axi_bram_dout(data_bram_dout_i), // Output from Core (BRAM read data)
     .axi_bram_we(data_bram_we_o),     // Input to Core
-    .axi_bram_en(data_bram_en_o)      // Input to Core
+    .axi_bram_en(data_bram_en_o),     // Input to Core
+
+    // Performance counters
+    .perf_sel(perf_sel),
+    .perf_clear(perf_clear),
+    .perf_data(perf_data)
 );
 
 endmodule
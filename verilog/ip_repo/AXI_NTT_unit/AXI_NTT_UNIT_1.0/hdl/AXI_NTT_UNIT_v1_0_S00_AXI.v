@@ -2,8 +2,14 @@
 // AXI-Lite Control Slave for NTT Unit
 // Connects AXI-Lite registers to the core's control/status signals.
 // Register Map:
-// 0x00 (slv_reg0): Control (R/W) - [0]=START, [1]=MODE (0=NTT, 1=iNTT)
-// 0x04 (slv_reg1): Status (R/O) - [0]=DONE, [1]=BUSY, [2]=ERROR
+// 0x00 (slv_reg0): Control (R/W) - [0]=START, [1]=MODE (0=NTT, 1=iNTT), [4:2]=COUNT (polynomials, 0/1=one),
+//                  [5]=SCHEME (dual-mode builds: 1 = second modulus, ignored otherwise)
+// 0x04 (slv_reg1): Write [0]=IRQ clear (level, write 1 then 0)
+//                  Read  [0]=DONE (IRQ latched), [1]=BUSY (START edges ignored while set),
+//                        [2]=ERROR (a START edge was dropped because the unit was busy),
+//                        [3]=DUAL (built with a second modulus, SCHEME is honoured)
+// 0x08 (slv_reg2): Perf control (R/W) - [4:0]=SEL (bit 4: 0=last job, 1=free running), [31]=CLEAR totals
+// 0x0C (slv_reg3): Perf data (R/O) - counter selected by SEL (see NTT_perf_counters)
 // =============================================================================
 `timescale 1 ns / 1 ps
 
@@ -24,10 +30,20 @@
         // Outputs to the NTT Core (Control Signals)
         output wire ntt_start_o,    // Bit 0 of slv_reg0: Start the operation (typically edge-triggered in core)
         output wire ntt_mode_o,     // Bit 1 of slv_reg0: 0=NTT, 1=iNTT
+        output wire [2:0] ntt_count_o, // Bits 4:2 of slv_reg0: polynomials per start (banks 0..COUNT-1)
+        output wire ntt_scheme_o,   // Bit 5 of slv_reg0: second modulus (dual-mode builds)
 
         // Inputs from the NTT Core (Status Signals)
-        output wire ntt_int_clear,      // NTT done interrupt latch  (for slv_reg1[1])
-        input wire ntt_error_i,     // Error status (for slv_reg1[2])
+        output wire ntt_int_clear,      // Bit 0 of slv_reg1: clears the done interrupt latch
+        input wire ntt_done_i,      // Done status, interrupt latched (read as slv_reg1[0])
+        input wire ntt_busy_i,      // Busy status (read as slv_reg1[1])
+        input wire ntt_error_i,     // Error status, start dropped (read as slv_reg1[2])
+        input wire ntt_dual_i,      // Dual-mode build (read as slv_reg1[3])
+
+        // Performance counters
+        output wire [4:0] perf_sel_o,   // slv_reg2[4:0]: counter select
+        output wire perf_clear_o,       // slv_reg2[31]: hold free-running counters at zero
+        input wire [C_S_AXI_DATA_WIDTH-1:0] perf_data_i, // read back through slv_reg3
 
         // User ports ends
         // Do not modify the ports beyond this line
@@ -118,9 +134,9 @@
     //------------------------------------------------
     //-- Number of Slave Registers 4
     reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg0; // Control Register
-    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg1; // Status Register (R/O)
-    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg2;
-    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg3;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg1; // IRQ clear (W), reads return the status
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg2; // Perf control
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg3; // Perf data (R/O, unused storage)
     wire     slv_reg_rden;
     wire     slv_reg_wren;
     reg [C_S_AXI_DATA_WIDTH-1:0]     reg_data_out;
@@ -256,20 +272,15 @@
                     // Slave register 0
                     slv_reg1[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
                 end
-              2'h2: // slv_reg2 (Writable)
+              2'h2: // slv_reg2 (Perf control - Writable)
                 for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
                   if ( S_AXI_WSTRB[byte_index] == 1 ) begin
                     // Respective byte enables are asserted as per write strobes 
                     // Slave register 2
                     slv_reg2[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
                   end  
-              2'h3: // slv_reg3 (Writable)
-                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
-                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
-                    // Respective byte enables are asserted as per write strobes 
-                    // Slave register 3
-                    slv_reg3[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
-                  end  
+              2'h3: // slv_reg3 (Perf data - Read only, writes are ignored)
+                slv_reg3 <= slv_reg3;
               default : begin
                           slv_reg0 <= slv_reg0;
                           slv_reg1 <= slv_reg1;
@@ -384,9 +395,9 @@
           // Address decoding for reading registers
           case ( axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] )
             2'h0   : reg_data_out <= slv_reg0; // Control Register
-            2'h1   : reg_data_out <= slv_reg1; // Status Register
-            2'h2   : reg_data_out <= slv_reg2;
-            2'h3   : reg_data_out <= slv_reg3;
+            2'h1   : reg_data_out <= {{(C_S_AXI_DATA_WIDTH-4){1'b0}}, ntt_dual_i, ntt_error_i, ntt_busy_i, ntt_done_i}; // Status
+            2'h2   : reg_data_out <= slv_reg2; // Perf control
+            2'h3   : reg_data_out <= perf_data_i; // Perf data
             default : reg_data_out <= 0;
           endcase
     end
@@ -417,11 +428,23 @@
     // slv_reg0 (0x00) -> Control Register
     // [0] = ntt_start_o (Start/Run)
     // [1] = ntt_mode_o (0=NTT, 1=iNTT)
+    // [4:2] = ntt_count_o (vector length, one IRQ after the last polynomial)
+    // [5] = ntt_scheme_o (dual-mode builds: 0 = Q, 1 = Q_ALT, latched with MODE)
     // -------------------------------------------------------------------------
     assign ntt_start_o = slv_reg0[0];
     assign ntt_mode_o  = slv_reg0[1];
+    assign ntt_count_o = slv_reg0[4:2];
+    assign ntt_scheme_o = slv_reg0[5];
 
     assign ntt_int_clear = slv_reg1[0];
+
+    // -------------------------------------------------------------------------
+    // slv_reg2 (0x08) -> Performance counter control
+    // [4:0]  = perf_sel_o, counter returned by reads of 0x0C
+    // [31]   = perf_clear_o, free-running counters held at zero while set
+    // -------------------------------------------------------------------------
+    assign perf_sel_o   = slv_reg2[4:0];
+    assign perf_clear_o = slv_reg2[31];
     // User logic ends
 
     endmodule
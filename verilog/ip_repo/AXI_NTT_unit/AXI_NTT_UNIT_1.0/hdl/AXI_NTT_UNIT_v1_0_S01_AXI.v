@@ -2,7 +2,8 @@
 module AXI_NTT_UNIT_v1_0_S01_AXI #
     (
         // Users to add parameters here
-
+        // Coefficient width of the core memory, the low bits of each 32-bit word
+        parameter integer C_COEF_WIDTH    = 12,
         // User parameters ends
         // Do not modify the parameters beyond this line
 
@@ -27,8 +28,8 @@ module AXI_NTT_UNIT_v1_0_S01_AXI #
         // Users to add ports here
         // BRAM Interface Ports for Top-Level Connection
         output reg [C_S_AXI_ADDR_WIDTH-1:0] data_bram_addr_o,
-        output reg [11:0] data_bram_din_o,
-        input wire [11:0] data_bram_dout_i, // Read data from BRAM to AXI Slave handler
+        output reg [C_COEF_WIDTH-1:0] data_bram_din_o,
+        input wire [C_COEF_WIDTH-1:0] data_bram_dout_i, // Read data from BRAM to AXI Slave handler
         output reg data_bram_we_o,
         output reg data_bram_en_o,
 
@@ -508,7 +509,7 @@ module AXI_NTT_UNIT_v1_0_S01_AXI #
     always @(*)
     begin
         // Default to the BRAM output for all cycles where RDATA could be relevant
-        axi_rdata = {{(C_S_AXI_DATA_WIDTH - 12){1'b0}}, data_bram_dout_i};
+        axi_rdata = {{(C_S_AXI_DATA_WIDTH - C_COEF_WIDTH){1'b0}}, data_bram_dout_i};
     end
 
     // Sequential block to control BRAM access (Address, Enable, Write Enable, Data In)
@@ -517,7 +518,7 @@ module AXI_NTT_UNIT_v1_0_S01_AXI #
         if (S_AXI_ARESETN == 1'b0)
         begin
             data_bram_addr_o <= 0;
-            data_bram_din_o <= 12'b0;
+            data_bram_din_o <= 0;
             data_bram_we_o <= 1'b0;
             data_bram_en_o <= 1'b0;
         end
@@ -531,7 +532,7 @@ module AXI_NTT_UNIT_v1_0_S01_AXI #
             begin
                 // Writing data (WVALID & WREADY handshake)
                 data_bram_we_o <= 1'b1;
-                data_bram_din_o <= S_AXI_WDATA[11:0]; // Store lower 12 bits
+                data_bram_din_o <= S_AXI_WDATA[C_COEF_WIDTH-1:0]; // Store the coefficient bits
                 data_bram_addr_o <= axi_awaddr;        // Use the current write address
             end
             // BRAM Read Logic
@@ -1,156 +1,309 @@
 `timescale 1ns / 1ps
 //////////////////////////////////////////////////////////////////////////////////
-// Company: 
-// Engineer: 
-// 
+// Company:
+// Engineer:
+//
 // Create Date: 23.07.2025 13:46:33
-// Design Name: 
+// Design Name:
 // Module Name: Mod_mul
-// Project Name: 
-// Target Devices: 
-// Tool Versions: 
-// Description: 
-// 
-// Dependencies: 
-// 
+// Project Name:
+// Target Devices:
+// Tool Versions:
+// Description:
+//
+// Dependencies:
+//
 // Revision:
+// Revision 0.03 - Width/modulus parameters, GENERIC Barrett for any q (Dilithium, dual-mode)
+// Revision 0.02 - Selectable IMPL and pipeline depth
 // Revision 0.01 - File Created
 // Additional Comments:
-// 
+//
 //////////////////////////////////////////////////////////////////////////////////
 
-//3 STAGE PIPELINED BARRET-LIKE MULTIPLY
-module Mod_mul(
+//PIPELINED MODULAR MULTIPLY, OUT = A*B mod q
+//IMPL selects the microarchitecture:
+//  "SHIFT_ADD"  : DSP product, Barrett-like quotient from shifts (c/3329 ~ c/4096(1+1/4-1/64-1/256))
+//  "BARRETT"    : DSP product, quotient (c * floor(2^24/q)) >> 24, one conditional subtraction
+//  "MONTGOMERY" : DSP product, two REDC steps (second one multiplies by R^2 mod q so twiddles stay in normal form)
+//  "BOOTH"      : radix-4 Booth product in LUTs (no DSP), SHIFT_ADD reduction
+//  "GENERIC"    : DSP product, Barrett with k = bit length of q: quotient ((c >> (k-1)) * mu) >> (k+1),
+//                 mu = floor(4^k / q), two conditional subtractions. Any q < 2^WIDTH.
+//THE FIRST FOUR ARE KYBER-SPECIFIC: ANY OTHER WIDTH/Q, OR A DUAL-MODE BUILD, USES "GENERIC".
+//DUAL-MODE (Q_ALT != 0): alt SELECTS Q_ALT, IT MUST BE HELD WHILE PRODUCTS ARE IN FLIGHT.
+//23-BIT OPERANDS (DILITHIUM) TILE THE PRODUCT OVER TWO DSP48 SLICES, KEEP LATENCY >= 3.
+//EVERY IMPL IS SPLIT IN 4 STEPS (PRODUCT, QUOTIENT, QUOTIENT*q, CORRECTION).
+//LATENCY REGISTERS ARE PLACED AFTER THE STEPS:
+//  1 -> {1}   2 -> {1,3}   3 -> {1,2,3} (ORIGINAL LAYOUT)   4 -> {1,2,3,4}   >4 -> EXTRA OUTPUT REGISTERS
+module Mod_mul #(
+        parameter IMPL    = "SHIFT_ADD",
+        parameter LATENCY = 3,          //CLOCK CYCLES FROM A,B TO OUT, >= 1
+        parameter WIDTH   = 12,         //OPERAND WIDTH, q < 2^WIDTH
+        parameter Q       = 3329,       //KYBER module
+        parameter Q_ALT   = 0           //SECOND MODULUS, 0 = SINGLE-MODE (alt IGNORED)
+    )(
         clk, r,     //CLOCK, RESET
-        A,B,        //12-BIT INPUTS
+        A,B,        //WIDTH-BIT INPUTS
+        alt,        //DUAL-MODE: REDUCE MOD Q_ALT
         valid_in,   //PIPELINE CONTROL SIGNAL
-        
+
         valid_out,  //PIPELINE CONTROL SIGNAL
-        OUT         //12-BIT OUTPUT
+        OUT         //WIDTH-BIT OUTPUT
     );
     input wire clk, r;
-    input wire[11:0] A,B;
+    input wire[WIDTH-1:0] A,B;
+    input wire alt;
     input wire valid_in;
-    
+
     output wire valid_out;
-    output wire[11:0] OUT;
- 
-    
-    localparam q = 3329; //KYBER module
-    
-    // MULTIPLY A*B
-    wire[23:0] c;
-    assign c = A*B;
-    
-    //STAGE 1 PIPELINE INPUT
-    reg[23:0] c_reg;
-    always @(posedge clk, posedge r) begin
-        if (r == 1'b1)
-            c_reg <= 23'b0;
-        else
-            c_reg <= c;
-    end
-    
+    output wire[WIDTH-1:0] OUT;
+
+
+    localparam q = Q;
+
+    localparam KYBER    = (WIDTH == 12) && (Q == 3329) && (Q_ALT == 0);
+    localparam EFF_IMPL = KYBER ? IMPL : "GENERIC";
+    localparam PW       = 2 * WIDTH; //PRODUCT WIDTH
+
+    //GENERIC BARRETT CONSTANTS PER MODULUS
+    localparam K_A = $clog2(Q);
+    localparam K_B = (Q_ALT != 0) ? $clog2(Q_ALT) : K_A;
+    localparam [63:0] MU_A = (64'd1 << (2 * K_A)) / Q;
+    localparam [63:0] MU_B = (Q_ALT != 0) ? (64'd1 << (2 * K_B)) / Q_ALT : MU_A;
+
+    wire sel_alt = (Q_ALT != 0) && alt;
+
+    localparam BARRETT_MU = 5039; //floor(2^24 / q)
+    localparam MONT_QINV  = 3327; //-q^-1 mod 2^16
+    localparam MONT_R2    = 1353; //2^32 mod q
+
+    localparam [3:0] REG_AFTER = (LATENCY <= 1) ? 4'b0001 :
+                                 (LATENCY == 2) ? 4'b0101 :
+                                 (LATENCY == 3) ? 4'b0111 : 4'b1111;
+    localparam EXTRA = (LATENCY > 4) ? LATENCY - 4 : 0;
+
     //SHIFT REGISTER FOR VALID DATA OUTPUT SIGNAL
-    reg [2:0] valid_pipe;
-    assign valid_out = valid_pipe[2]; // output is delayed 3 cycles
+    reg [LATENCY-1:0] valid_pipe;
+    assign valid_out = valid_pipe[LATENCY-1]; // output is delayed LATENCY cycles
 
     always @(posedge clk, posedge r) begin
         if (r == 1'b1)
-            valid_pipe <= 3'b000;
+            valid_pipe <= 0;
+        else if (LATENCY == 1)
+            valid_pipe <= valid_in;
         else
-            valid_pipe <= {valid_pipe[1:0], valid_in};
+            valid_pipe <= {valid_pipe, valid_in};
     end
 
-    
-    //STEP 1: CALCULATE m_hat = ceil(c/q) = c/3329 = c/4096(1+1/4-1/64-1/256) ~ (c >> 12) + (c >> 14) - (c >> 18) - (c >> 20)
-    wire[23:0] m_hat;
-    assign m_hat = (c_reg >> 12) + (c_reg >> 14) - ((c_reg >> 18) + (c_reg >> 20));
-    
-    //CORRECTION FACTOR DUE TO LOSS OF INFORMATION FROM SHIFTING
-    //STEP 2:correct = round((c[11:9] + c[13:11] - c[17:15] - c[19:17]) >> 3) = ((c[11:9] + c[13:11] - c[17:15] - c[19:17] + 4) >> 3)
-    // Extract fields as signed (4-bit is sufficient for 3-bit fields)
-    wire[2:0] a11_9   = c_reg[11:9];
-    wire[2:0] a13_11  = c_reg[13:11];
-    wire[2:0] a17_15  = c_reg[17:15];
-    wire[2:0] a19_17  = c_reg[19:17];
-    
-    
-    // Compute raw correction
-    wire[4:0] correct_raw = (a11_9 + a13_11 - a17_15 - a19_17);
-    wire signed[4:0] correct_raw_signed = correct_raw;
-    // True signed rounding to nearest
-    wire signed [5:0] biased;
-    assign biased = (correct_raw_signed >= 0) ? 
-                    (correct_raw_signed + 4) : (correct_raw_signed - 4);
-    
-    // Perform logic shift right (acts as unsigned division by 8)
-    wire signed[2:0] abs_shifted;
-    assign abs_shifted = (biased > -8 && biased < 0) ? 0 :
-                         (biased <= -8 && biased > -16) ? -1 :
-                         (biased <= -16) ? -2 : biased >> 3;
-    
-    // Now manually restore sign
-    wire signed [2:0] correct;
-    assign correct = abs_shifted;
-    
-    /*wire signed[4:0] correct_temp;
-    assign correct_temp = (correct_raw >= 0) ?
-                     ((correct_raw + 6'sd4)) :
-                     ((correct_raw - 6'sd4));
-    
-    wire signed[1:0] correct_temp_shift = correct_temp[4:3];
-    
-    wire signed[1:0] correct = correct_raw[4:3];
-    assign correct = (correct_temp > 1)  ? 2'sd1 :
-                     (correct_temp < -1) ? -2'sd1 :
-                        correct_temp;*/
-    
-    //STEP 3: m = m_hat + correct
-    wire[23:0] m;
-    //assign m = (m_hat === 0) ? $signed(m_hat) : $signed(m_hat) + correct;
-    assign m = $signed(m_hat) + correct;
-    
-    //STAGE 2 PIPELINE INPUT
-    reg[23:0] c_stage2;
-    reg[23:0] m_reg;
-    always @(posedge clk, posedge r) begin
-        if (r == 1'b1) begin
-            m_reg <= 23'b0;
-            c_stage2 <= 23'b0;
+    //-------------------------------------------------------------------------
+    //REDUCTION STEPS. EVERY STEP CARRIES THE PRODUCT ALONG: {c[PW-1:0], w[PW-1:0]}
+    //-------------------------------------------------------------------------
+
+    //MONTGOMERY REDC: t * 2^-16 mod q, FOR t < q * 2^16
+    function [11:0] redc;
+        input [23:0] t;
+        reg [15:0] m;
+        reg [28:0] s;
+        reg [12:0] u;
+        begin
+            m = t[15:0] * MONT_QINV;
+            s = t + m * q;
+            u = s >> 16;
+            redc = (u >= q) ? u - q : u;
         end
-        else begin
-            m_reg <= m;
-            c_stage2 <= c_reg;
+    endfunction
+
+    //STEP 2 OF SHIFT_ADD/BOOTH: m = ceil(c/q) ~ m_hat + correct
+    function [23:0] shift_add_quotient;
+        input [23:0] c;
+        reg [23:0] m_hat;
+        reg [4:0] correct_raw;
+        reg signed [4:0] correct_raw_signed;
+        reg signed [5:0] biased;
+        reg signed [2:0] correct;
+        begin
+            //m_hat = (c >> 12) + (c >> 14) - (c >> 18) - (c >> 20)
+            m_hat = (c >> 12) + (c >> 14) - ((c >> 18) + (c >> 20));
+
+            //CORRECTION FACTOR DUE TO LOSS OF INFORMATION FROM SHIFTING
+            //correct = round((c[11:9] + c[13:11] - c[17:15] - c[19:17]) >> 3)
+            correct_raw = c[11:9] + c[13:11] - c[17:15] - c[19:17];
+            correct_raw_signed = correct_raw;
+            // True signed rounding to nearest
+            biased = (correct_raw_signed >= 0) ?
+                     (correct_raw_signed + 4) : (correct_raw_signed - 4);
+            correct = (biased > -8 && biased < 0) ? 0 :
+                      (biased <= -8 && biased > -16) ? -1 :
+                      (biased <= -16) ? -2 : biased >> 3;
+
+            shift_add_quotient = $signed(m_hat) + correct;
         end
-    end
-    
-    //STEP 4: x = c - (q * m)
-    //MULTIPLY q * m
-    //q = 3329 = 2^11 + 2^10 + 2^8 + 1
-    //HENCE q * m = m * (2^11 + 2^10 + 2^8 + 1) = (m << 11) + (m << 10) + (m << 8) + m
-    wire[23:0] q_mul_m;
-    assign q_mul_m = (m_reg << 11) + (m_reg << 10) + (m_reg << 8) + m_reg;
-    
-    //STAGE 3 PIPELINE INPUT
-    reg[23:0] c_stage3;
-    reg[23:0] q_mul_m_reg;
-    
-    always @(posedge clk, posedge r) begin
-        if (r == 1'b1) begin
-            q_mul_m_reg <= 23'b0;
-            c_stage3 <= 0;
+    endfunction
+
+    //STEPS 2-4 OF GENERIC, FOR MODULUS qm WITH BIT LENGTH km AND mu
+    function [PW-1:0] generic_quotient;
+        input [PW-1:0] c;
+        input integer km;
+        input [63:0] mu;
+        reg [PW+3:0] t;
+        begin
+            t = (c >> (km - 1)) * mu;
+            generic_quotient = t >> (km + 1);
         end
-        else begin
-            q_mul_m_reg <= q_mul_m;
-            c_stage3 <= c_stage2;
+    endfunction
+
+    function [PW-1:0] generic_correct;
+        input [PW-1:0] c, qw;   //c AND q * QUOTIENT, c - qw < 3q
+        input [PW-1:0] qm;
+        reg [PW-1:0] rem;
+        begin
+            rem = c - qw;
+            if (rem >= qm) rem = rem - qm;
+            if (rem >= qm) rem = rem - qm;
+            generic_correct = rem;
         end
-    end
-    
-    //FINISH STEP 4
-    wire signed[12:0] x;
-    assign x = c_stage3 - q_mul_m_reg;
-    
-    //STEP 5: if x < 0 then x = x + q
-    assign OUT = x[12] ? x[11:0] + q : x[11:0]; 
+    endfunction
+
+    function [2*PW-1:0] step;
+        input integer k;
+        input [2*PW-1:0] x;
+        input sel;      //GENERIC: Q_ALT
+        reg [PW-1:0] c, w, prod;
+        reg [36:0] wide;
+        reg signed [12:0] diff;
+        reg [12:0] rem;
+        reg [11:0] res;
+        begin
+            c = x[2*PW-1:PW];
+            w = x[PW-1:0];
+            step = x;
+            case (k)
+                //STEP 2: QUOTIENT ESTIMATE (MONTGOMERY: FIRST REDC)
+                2: begin
+                    if (EFF_IMPL == "GENERIC")
+                        step = {c, generic_quotient(c, sel ? K_B : K_A, sel ? MU_B : MU_A)};
+                    else if (EFF_IMPL == "BARRETT") begin
+                        wide = c * BARRETT_MU;
+                        step = {c, 11'b0, wide[36:24]};
+                    end else if (EFF_IMPL == "MONTGOMERY")
+                        step = {c, 12'b0, redc(c)};
+                    else
+                        step = {c, shift_add_quotient(c)};
+                end
+                //STEP 3: q * QUOTIENT (MONTGOMERY: SECOND PRODUCT BY R^2)
+                //q = 3329 = 2^11 + 2^10 + 2^8 + 1 -> SHIFT_ADD USES SHIFTS
+                3: begin
+                    if (EFF_IMPL == "GENERIC")
+                        prod = w * (sel ? Q_ALT : Q);
+                    else if (EFF_IMPL == "BARRETT")
+                        prod = w[12:0] * q;
+                    else if (EFF_IMPL == "MONTGOMERY")
+                        prod = w[11:0] * MONT_R2;
+                    else
+                        prod = (w << 11) + (w << 10) + (w << 8) + w;
+                    step = {c, prod};
+                end
+                //STEP 4: FINAL CORRECTION INTO [0, q)
+                4: begin
+                    if (EFF_IMPL == "GENERIC")
+                        step = {c, generic_correct(c, w, sel ? Q_ALT : Q)};
+                    else if (EFF_IMPL == "BARRETT") begin
+                        rem = c - w;
+                        res = (rem >= q) ? rem - q : rem;
+                    end else if (EFF_IMPL == "MONTGOMERY")
+                        res = redc(w);
+                    else begin
+                        //x = c - q*m, if x < 0 then x = x + q
+                        diff = c - w;
+                        res = diff[12] ? diff[11:0] + q : diff[11:0];
+                    end
+                    if (EFF_IMPL != "GENERIC")
+                        step = {c, 12'b0, res};
+                end
+            endcase
+        end
+    endfunction
+
+    //STEP 1: MULTIPLY A*B
+    wire[2*PW-1:0] s1;
+
+    generate
+        if (EFF_IMPL == "BOOTH") begin : booth
+            //RADIX-4 BOOTH: 7 DIGITS IN {-2..2} FROM {00, B, 0}, PARTIAL PRODUCTS SUMMED IN FABRIC
+            (* use_dsp = "no" *) reg signed [25:0] acc;
+            reg signed [25:0] a_s, pp;
+            reg [14:0] b_ext;
+            integer i;
+
+            always @(*) begin
+                a_s   = {14'b0, A};
+                b_ext = {2'b00, B, 1'b0};
+                acc   = 0;
+                for (i = 0; i < 7; i = i + 1) begin
+                    case (b_ext[2*i +: 3])
+                        3'b001, 3'b010: pp = a_s;
+                        3'b011:         pp = a_s <<< 1;
+                        3'b100:         pp = -(a_s <<< 1);
+                        3'b101, 3'b110: pp = -a_s;
+                        default:        pp = 0;
+                    endcase
+                    acc = acc + (pp <<< (2*i));
+                end
+            end
+
+            assign s1 = {acc[23:0], 24'b0};
+        end
+        else begin : dsp
+            wire[PW-1:0] c;
+            assign c = A*B;
+            assign s1 = {c, {PW{1'b0}}};
+        end
+    endgenerate
+
+    //PIPELINE: p[k] IS THE (OPTIONALLY REGISTERED) RESULT OF STEP k
+    wire[2*PW-1:0] p [1:4];
+    wire[2*PW-1:0] s [1:4];
+    assign s[1] = s1;
+
+    genvar k;
+    generate
+        for (k = 1; k <= 4; k = k + 1) begin : stage
+            if (k > 1) begin : comb
+                assign s[k] = step(k, p[k-1], sel_alt);
+            end
+
+            if (REG_AFTER[k-1]) begin : pipe
+                reg[2*PW-1:0] p_reg;
+                always @(posedge clk, posedge r) begin
+                    if (r == 1'b1)
+                        p_reg <= {2*PW{1'b0}};
+                    else
+                        p_reg <= s[k];
+                end
+                assign p[k] = p_reg;
+            end
+            else begin : pass
+                assign p[k] = s[k];
+            end
+        end
+
+        //EXTRA OUTPUT REGISTERS FOR LATENCY > 4 (RETIMING SLACK)
+        if (EXTRA > 0) begin : out_pipe
+            reg[WIDTH-1:0] out_pipe [0:EXTRA-1];
+            integer e;
+            always @(posedge clk, posedge r) begin
+                if (r == 1'b1) begin
+                    for (e = 0; e < EXTRA; e = e + 1) out_pipe[e] <= {WIDTH{1'b0}};
+                end
+                else begin
+                    out_pipe[0] <= p[4][WIDTH-1:0];
+                    for (e = 1; e < EXTRA; e = e + 1) out_pipe[e] <= out_pipe[e-1];
+                end
+            end
+            assign OUT = out_pipe[EXTRA-1];
+        end
+        else begin : no_out_pipe
+            assign OUT = p[4][WIDTH-1:0];
+        end
+    endgenerate
 endmodule
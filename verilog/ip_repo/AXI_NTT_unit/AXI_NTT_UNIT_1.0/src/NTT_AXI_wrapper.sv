@@ -1,34 +1,114 @@
 `timescale 1ns / 1ps
 
-module NTT_AXI_wrapper (
+module NTT_AXI_wrapper #(
+    parameter        MUL_IMPL    = "SHIFT_ADD", // Mod_mul: SHIFT_ADD, BARRETT, MONTGOMERY, BOOTH (Kyber), GENERIC
+    parameter int    MUL_LATENCY = 3,           // Mod_mul pipeline depth, also the controller's write-back delay
+    parameter int    MAX_POLYS   = 4,           // coefficient banks, polynomials per command
+    // Datapath: Kyber by default. Dilithium: DATA_WIDTH 23, Q 8380417, OMEGA 3602218.
+    // Q_ALT/OMEGA_ALT != 0 builds a dual-mode unit, the scheme input picks the second
+    // modulus per command (DATA_WIDTH must hold both). OMEGA has order 128 mod Q.
+    parameter int     DATA_WIDTH = 12,
+    parameter longint Q          = 3329,
+    parameter longint OMEGA      = 910,
+    parameter longint Q_ALT      = 0,
+    parameter longint OMEGA_ALT  = 0,
+    localparam int   PW          = $clog2(MAX_POLYS)
+)(
     input   logic        clk,
     input   logic        rst,
     input   logic        start,
     input   logic        mode,
-    output  logic        done,
+    input   logic        scheme, // dual-mode: 1 = Q_ALT, latched with mode
+    input   logic [2:0]  count, // polynomials to transform back to back (0 and 1 both mean one)
+    output  logic        done,  // after the last polynomial
+    output  logic        busy,  // vector command running, start edges are ignored meanwhile
+    output  logic        start_dropped, // sticky: a start edge came while busy, cleared by the next accepted start
     
-    // AXI4 (DMA) - simple read/write ports for coefficients
-    input  logic [7:0]  axi_bram_addr,
-    input  logic [11:0] axi_bram_din,
-    output logic [11:0] axi_bram_dout,
+    // AXI4 (DMA) - simple read/write ports for coefficients, bank = axi_bram_addr[7+PW:8]
+    input  logic [7+PW:0] axi_bram_addr,
+    input  logic [DATA_WIDTH-1:0] axi_bram_din,
+    output logic [DATA_WIDTH-1:0] axi_bram_dout,
     input  logic        axi_bram_we,
     input  logic        axi_bram_en,
 
-    output logic        irq  // interrupt to PS when done
+    output logic        irq,  // interrupt to PS when done
+
+    // Performance counters (NTT_perf_counters)
+    input  logic [4:0]  perf_sel,
+    input  logic        perf_clear,
+    output logic [31:0] perf_data
 );
 
+    // ------------------------------------------------------------------------
+    // Vector sequencer
+    //  - a rising edge of start latches mode, scheme and count, then the controller
+    //    runs once per polynomial, bank 0 first
+    //  - the next polynomial is kicked off in the IDLE cycle after DONE
+    //  - done (and the IRQ) only follows the last polynomial
+    //  - a start edge while busy is not queued: it sets start_dropped instead, which
+    //    the driver reads back as the ERROR bit of the status register
+    // ------------------------------------------------------------------------
+    localparam int POLY_W = (PW > 0) ? PW : 1;
+
+    logic              start_q, mode_q, scheme_q, seq_busy, kick;
+    logic [POLY_W-1:0] poly, last_poly;
+    logic              ctrl_done;
+
+    wire start_edge  = start && !start_q;
+    wire job_start   = start_edge && !seq_busy;
+    wire ctrl_enable = job_start || kick;
+    wire ctrl_mode   = job_start ? mode : mode_q;
+    wire alt         = (Q_ALT != 0) && (job_start ? scheme : scheme_q);
+    wire last_done   = ctrl_done && (poly == last_poly);
+
+    always_ff @(posedge clk, posedge rst) begin
+        if (rst) begin
+            start_q   <= 1'b0;
+            mode_q    <= 1'b0;
+            scheme_q  <= 1'b0;
+            seq_busy  <= 1'b0;
+            kick      <= 1'b0;
+            poly      <= '0;
+            last_poly <= '0;
+            start_dropped <= 1'b0;
+        end else begin
+            start_q <= start;
+            kick    <= 1'b0;
+            if (job_start)
+                start_dropped <= 1'b0;
+            else if (start_edge)
+                start_dropped <= 1'b1;
+            if (job_start) begin
+                seq_busy  <= 1'b1;
+                mode_q    <= mode;
+                scheme_q  <= scheme;
+                poly      <= '0;
+                last_poly <= (count <= 1) ? '0 :
+                             (count >= MAX_POLYS) ? POLY_W'(MAX_POLYS - 1) : POLY_W'(count - 1);
+            end else if (last_done) begin
+                seq_busy <= 1'b0;
+            end else if (ctrl_done) begin
+                poly <= poly + 1'b1;
+                kick <= 1'b1;
+            end
+        end
+    end
+
+    assign done = last_done;
+    assign busy = seq_busy;
+
     // ------------------------------------------------------------------------
     // BRAM interface signals
     // ------------------------------------------------------------------------
     logic [7:0] ctrl_bram0_addr_a, ctrl_bram0_addr_b;
     logic ctrl_bram0_we_a, ctrl_bram0_we_b;
-    logic [11:0] ctrl_bram0_din_a, ctrl_bram0_din_b;
-    logic [11:0] ctrl_bram0_dout_a, ctrl_bram0_dout_b;
+    logic [DATA_WIDTH-1:0] ctrl_bram0_din_a, ctrl_bram0_din_b;
+    logic [DATA_WIDTH-1:0] ctrl_bram0_dout_a, ctrl_bram0_dout_b;
 
     logic [7:0] ctrl_bram1_addr_a, ctrl_bram1_addr_b;
     logic ctrl_bram1_we_a, ctrl_bram1_we_b;
-    logic [11:0] ctrl_bram1_din_a, ctrl_bram1_din_b;
-    logic [11:0] ctrl_bram1_dout_a, ctrl_bram1_dout_b;
+    logic [DATA_WIDTH-1:0] ctrl_bram1_din_a, ctrl_bram1_din_b;
+    logic [DATA_WIDTH-1:0] ctrl_bram1_dout_a, ctrl_bram1_dout_b;
 
     // ------------------------------------------------------------------------
     // BRAM port muxing between DMA and Controller
@@ -36,12 +116,15 @@ module NTT_AXI_wrapper (
     //  - Port B: always used by the NTT controller
     // ------------------------------------------------------------------------
 
-    // For simplicity, we'll only give AXI access to BRAM0
-    wire [7:0]  bram0_addr_a;
-    wire [11:0] bram0_din_a;
+    // For simplicity, we'll only give AXI access to BRAM0. BRAM0 holds one bank
+    // per polynomial, the controller works in bank 'poly'; BRAM1 is scratch
+    // for the odd stages and stays a single bank.
+    wire [7+PW:0] bram0_addr_a, bram0_addr_b;
+    wire [DATA_WIDTH-1:0] bram0_din_a;
     wire        bram0_we_a;
     
-    assign bram0_addr_a = axi_bram_en ? axi_bram_addr : ctrl_bram0_addr_a;
+    assign bram0_addr_a = axi_bram_en ? axi_bram_addr : (8+PW)'({poly, ctrl_bram0_addr_a});
+    assign bram0_addr_b = (8+PW)'({poly, ctrl_bram0_addr_b});
     assign bram0_din_a  = axi_bram_en ? axi_bram_din  : ctrl_bram0_din_a;
     assign bram0_we_a  = axi_bram_en ? axi_bram_we   : ctrl_bram0_we_a;
     assign axi_bram_dout = ctrl_bram0_dout_a;
@@ -49,7 +132,10 @@ module NTT_AXI_wrapper (
     // ------------------------------------------------------------------------
     // BRAM instantiation (two ping-pong memories)
     // ------------------------------------------------------------------------
-    BRAM_256x12 bram0 (
+    BRAM_256x12 #(
+        .BANKS(MAX_POLYS),
+        .WIDTH(DATA_WIDTH)
+    ) bram0 (
         .clk(clk),
         
         .en_a(1'b1),
@@ -60,12 +146,14 @@ module NTT_AXI_wrapper (
 
         .en_b(1'b1),
         .we_b(ctrl_bram0_we_b),
-        .addr_b(ctrl_bram0_addr_b),
+        .addr_b(bram0_addr_b),
         .din_b(ctrl_bram0_din_b),
         .dout_b(ctrl_bram0_dout_b)
     );
 
-    BRAM_256x12 bram1 (
+    BRAM_256x12 #(
+        .WIDTH(DATA_WIDTH)
+    ) bram1 (
         .clk(clk),
         
         .en_a(1'b1),
@@ -85,24 +173,37 @@ module NTT_AXI_wrapper (
     // Twiddle ROM
     // ------------------------------------------------------------------------
     logic [7:0]  rom_addr;
-    logic [11:0] rom_dout;
+    logic [DATA_WIDTH-1:0] rom_dout;
 
-    twiddle_ROM twiddle_rom (
+    twiddle_ROM #(
+        .WIDTH(DATA_WIDTH),
+        .Q(Q),
+        .OMEGA(OMEGA),
+        .Q_ALT(Q_ALT),
+        .OMEGA_ALT(OMEGA_ALT)
+    ) twiddle_rom (
         .clk(clk),
         .addr(rom_addr),
+        .alt(alt),
         .dout(rom_dout)
     );
 
     // ------------------------------------------------------------------------
     // Butterfly Unit
     // ------------------------------------------------------------------------
-    logic [11:0] butterfly_in1, butterfly_in2;
-    logic [11:0] butterfly_twiddle;
+    logic [DATA_WIDTH-1:0] butterfly_in1, butterfly_in2;
+    logic [DATA_WIDTH-1:0] butterfly_twiddle;
     logic butterfly_inverse;
     logic valid_in, valid_out;
-    logic [11:0] butterfly_u, butterfly_v;
+    logic [DATA_WIDTH-1:0] butterfly_u, butterfly_v;
 
-    Butterfly_unit butterfly (
+    Butterfly_unit #(
+        .MUL_IMPL(MUL_IMPL),
+        .LATENCY(MUL_LATENCY),
+        .WIDTH(DATA_WIDTH),
+        .Q(Q),
+        .Q_ALT(Q_ALT)
+    ) butterfly (
         .IN_1(butterfly_in1),
         .IN_2(butterfly_in2),
         .twiddle(butterfly_twiddle),
@@ -111,6 +212,7 @@ module NTT_AXI_wrapper (
         .inverse(butterfly_inverse),
         .valid_in(valid_in),
         .valid_out(valid_out),
+        .alt(alt),
         .U_OUT(butterfly_u),
         .V_OUT(butterfly_v)
     );
@@ -118,17 +220,20 @@ module NTT_AXI_wrapper (
     // ------------------------------------------------------------------------
     // NTT Controller
     // ------------------------------------------------------------------------
+    logic ctrl_busy, ctrl_pipeline, ctrl_flush, ctrl_intt_wait;
+    logic [7:0] ctrl_stage;
+
     NTT_Controller #(
         .N(256),
         .ADDR_WIDTH(8),
-        .DATA_WIDTH(12),
-        .LATENCY(3)
+        .DATA_WIDTH(DATA_WIDTH),
+        .LATENCY(MUL_LATENCY)
     ) controller (
         .clk(clk),
         .rst(rst),
-        .enable(start),
-        .mode(mode),
-        .done(done),
+        .enable(ctrl_enable),
+        .mode(ctrl_mode),
+        .done(ctrl_done),
 
         // BRAM 0
         .bram0_addr_a(ctrl_bram0_addr_a),
@@ -162,9 +267,38 @@ module NTT_AXI_wrapper (
         .valid_in(valid_in),
         .valid_out(valid_out),
         .butterfly_u(butterfly_u),
-        .butterfly_v(butterfly_v)
+        .butterfly_v(butterfly_v),
+
+        // Status
+        .status_busy(ctrl_busy),
+        .status_pipeline(ctrl_pipeline),
+        .status_flush(ctrl_flush),
+        .status_intt_wait(ctrl_intt_wait),
+        .status_stage(ctrl_stage)
     );
 
     assign irq = done;
 
+    // ------------------------------------------------------------------------
+    // Performance counters
+    // ------------------------------------------------------------------------
+    NTT_perf_counters #(
+        .LOGN(8),
+        .WIDTH(32)
+    ) perf (
+        .clk(clk),
+        .rst(rst),
+        .clear(perf_clear),
+        .busy(ctrl_busy || seq_busy),   // one job for the whole vector
+        .pipeline(ctrl_pipeline),
+        .stage(ctrl_stage),
+        .flush(ctrl_flush),
+        .intt_wait(ctrl_intt_wait),
+        .issue(valid_in),
+        .conflict(axi_bram_en && ctrl_busy), // AXI wins the port A mux over the controller
+        .done(done),
+        .sel(perf_sel),
+        .value(perf_data)
+    );
+
 endmodule
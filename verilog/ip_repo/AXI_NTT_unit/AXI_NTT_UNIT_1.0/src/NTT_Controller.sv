@@ -44,7 +44,14 @@ module NTT_Controller #(
     output logic                  valid_in,
     input  logic                  valid_out,
     input  logic [DATA_WIDTH-1:0] butterfly_u,
-    input  logic [DATA_WIDTH-1:0] butterfly_v
+    input  logic [DATA_WIDTH-1:0] butterfly_v,
+
+    // Status for the performance counters
+    output logic                  status_busy,      // not IDLE
+    output logic                  status_pipeline,  // PIPELINE (stage in status_stage)
+    output logic                  status_flush,     // FLUSH: draining the butterfly
+    output logic                  status_intt_wait, // INTT_WAIT: inverse warm-up
+    output logic [$clog2(N)-1:0]  status_stage
 );
 
     // Derived params
@@ -168,7 +175,7 @@ module NTT_Controller #(
         end
     end
 
-    // -------------------- issued / completed counters (no change) --------------------
+    // -------------------- issued / completed counters --------------------
     logic [11:0] issued_count;
     logic [11:0] completed_count;
 
@@ -188,7 +195,7 @@ module NTT_Controller #(
     wire butterflies_in_flight = (completed_count < issued_count);
 
 
-    //DELAY COUNTER FOR INTT INITIALISATION (no change)
+    //DELAY COUNTER FOR INTT INITIALISATION
     logic [1:0] intt_delay_cnt;
     
     always_ff @(posedge clk, posedge rst) begin
@@ -202,7 +209,7 @@ module NTT_Controller #(
         end
     end
     
-    // -------------------- FSM seq / next (no change) --------------------
+    // -------------------- FSM seq / next --------------------
     always_ff @(posedge clk, posedge rst) begin
         if (rst) state <= IDLE;
         else     state <= next_state;
@@ -214,7 +221,7 @@ module NTT_Controller #(
             IDLE: begin
                 if (enable) begin
                     if (mode == 1'b1)
-                        next_state = INTT_WAIT;   // new state for pipeline warm-up
+                        next_state = INTT_WAIT;   // state for pipeline warm-up
                     else
                         next_state = PIPELINE;
                 end
@@ -228,7 +235,6 @@ module NTT_Controller #(
             end
     
             PIPELINE: begin
-                // Logic updated to use current values of stage/start/j
                 if ((stage == MAX_STAGE) && (start == (N - 2*len)) && (j == len - 1'b1))
                     next_state = FLUSH;
             end
@@ -244,9 +250,6 @@ module NTT_Controller #(
         
 
     // -------------------- COUNTER NEXT-STATE CALCULATION (COMBINATIONAL) --------------------
-    // The inner-defaults from the last attempt have been removed, as they caused
-    // a conflict with the top-level defaults. We now rely on explicit coverage
-    // within the loop logic to avoid falling back to the top-level default implicitly.
     always_comb begin
         // Default: Hold current value (active in all FSM states except when a branch below overrides it)
         stage_next = stage;
@@ -303,7 +306,7 @@ module NTT_Controller #(
         end
     end
 
-    // -------------------- bank-swap delay counter (Refactored) --------------------
+    // -------------------- bank-swap delay counter --------------------
    
 
     always_ff @(posedge clk, posedge rst) begin
@@ -316,7 +319,7 @@ module NTT_Controller #(
                 src_bank <= src_bank; // explicitly hold
             end else if (bank_swap_cnt != '0) begin
                 if (bank_swap_cnt == 1) begin
-                    // The register resets for j/start/stage are handled by the main counter block now
+                    // The register resets for j/start/stage are handled by the main counter block
                     src_bank <= ~src_bank; // Only bank swap remains here
                     bank_swap_cnt <= '0;
                 end else begin
@@ -326,7 +329,7 @@ module NTT_Controller #(
         end
     end
 
-    // -------------------- butterfly I/O routing (no change) --------------------
+    // -------------------- butterfly I/O routing--------------------
     assign butterfly_inverse = mode_reg;
     assign butterfly_twiddle = rom_dout;
 
@@ -340,7 +343,7 @@ module NTT_Controller #(
         end
     end
 
-    // -------------------- BRAM port address & write logic (no change) --------------------
+    // -------------------- BRAM port address & write logic--------------------
     always_comb begin
         // defaults
         bram0_addr_a = '0; bram0_addr_b = '0;
@@ -375,7 +378,7 @@ module NTT_Controller #(
         end
     end
 
-    // valid_in sequential logic (no change)
+    // valid_in sequential logic
     logic valid_in_next;
     
     always_comb begin
@@ -392,4 +395,10 @@ module NTT_Controller #(
 
     assign done = (state == DONE);
 
+    assign status_busy      = (state != IDLE);
+    assign status_pipeline  = (state == PIPELINE);
+    assign status_flush     = (state == FLUSH);
+    assign status_intt_wait = (state == INTT_WAIT);
+    assign status_stage     = stage;
+
 endmodule
@@ -0,0 +1,102 @@
+`timescale 1ns / 1ps
+
+// PERFORMANCE COUNTERS FOR THE NTT CORE
+// Every event feeds two banks of counters:
+//  - JOB bank:   restarts when the controller leaves IDLE, holds its values after DONE
+//                until the next job starts -> per-job snapshot
+//  - TOTAL bank: free running, cleared while 'clear' is high
+// Read port: sel[4] = 0 JOB bank, 1 TOTAL bank; sel[3:0] = counter index below.
+module NTT_perf_counters #(
+    parameter int LOGN  = 8,
+    parameter int WIDTH = 32
+)(
+    input  logic            clk,
+    input  logic            rst,
+    input  logic            clear,
+
+    // events, one per cycle
+    input  logic            busy,           // controller not IDLE
+    input  logic            pipeline,       // PIPELINE state
+    input  logic [LOGN-1:0] stage,          // current stage while in PIPELINE
+    input  logic            flush,          // FLUSH stall
+    input  logic            intt_wait,      // INTT_WAIT stall
+    input  logic            issue,          // butterfly valid_in
+    input  logic            conflict,       // AXI took BRAM port A while the controller was active
+    input  logic            done,
+
+    input  logic [4:0]      sel,
+    output logic [WIDTH-1:0] value
+);
+
+    // counter indices (keep in sync with NTT_PERF_* in the driver)
+    localparam int CNT_BUSY      = 0;
+    localparam int CNT_STAGE0    = 1;               // 1 .. LOGN
+    localparam int CNT_FLUSH     = CNT_STAGE0 + LOGN;
+    localparam int CNT_INTT_WAIT = CNT_FLUSH + 1;
+    localparam int CNT_ISSUE     = CNT_FLUSH + 2;
+    localparam int CNT_CONFLICT  = CNT_FLUSH + 3;
+    localparam int CNT_JOBS      = CNT_FLUSH + 4;
+    localparam int NUM           = CNT_JOBS + 1;
+
+    // NUM must fit the 4-bit index of sel
+    if (NUM > 16) begin : num_check
+        $error("NTT_perf_counters: %0d counters do not fit sel[3:0]", NUM);
+    end
+
+    logic [NUM-1:0] ev;
+
+    always_comb begin
+        ev = '0;
+        ev[CNT_BUSY]      = busy;
+        for (int s = 0; s < LOGN; s++)
+            ev[CNT_STAGE0 + s] = pipeline && (stage == s);
+        ev[CNT_FLUSH]     = flush;
+        ev[CNT_INTT_WAIT] = intt_wait;
+        ev[CNT_ISSUE]     = issue;
+        ev[CNT_CONFLICT]  = conflict;
+        ev[CNT_JOBS]      = done;
+    end
+
+    // a job starts on the first busy cycle
+    logic busy_q;
+    wire  job_start = busy && !busy_q;
+
+    always_ff @(posedge clk, posedge rst) begin
+        if (rst) busy_q <= 1'b0;
+        else     busy_q <= busy;
+    end
+
+    logic [WIDTH-1:0] job   [0:NUM-1];
+    logic [WIDTH-1:0] total [0:NUM-1];
+
+    always_ff @(posedge clk, posedge rst) begin
+        if (rst) begin
+            for (int i = 0; i < NUM; i++) begin
+                job[i]   <= '0;
+                total[i] <= '0;
+            end
+        end else begin
+            for (int i = 0; i < NUM; i++) begin
+                if (job_start)
+                    job[i] <= WIDTH'(ev[i]);
+                else
+                    job[i] <= job[i] + ev[i];
+
+                if (clear)
+                    total[i] <= '0;
+                else
+                    total[i] <= total[i] + ev[i];
+            end
+        end
+    end
+
+    always_comb begin
+        if (sel[3:0] >= NUM)
+            value = '0;
+        else if (sel[4])
+            value = total[sel[3:0]];
+        else
+            value = job[sel[3:0]];
+    end
+
+endmodule
@@ -15,6 +15,15 @@ proc init_gui { IPINST } {
   ipgui::add_param $IPINST -name "C_S01_AXI_BUSER_WIDTH" -parent ${Page_0}
   ipgui::add_param $IPINST -name "C_S01_AXI_BASEADDR" -parent ${Page_0}
   ipgui::add_param $IPINST -name "C_S01_AXI_HIGHADDR" -parent ${Page_0}
+  #Adding Page
+  set Datapath [ipgui::add_page $IPINST -name "NTT Datapath"]
+  ipgui::add_param $IPINST -name "NTT_DATA_WIDTH" -parent ${Datapath}
+  ipgui::add_param $IPINST -name "NTT_Q" -parent ${Datapath}
+  ipgui::add_param $IPINST -name "NTT_OMEGA" -parent ${Datapath}
+  ipgui::add_param $IPINST -name "NTT_Q_ALT" -parent ${Datapath}
+  ipgui::add_param $IPINST -name "NTT_OMEGA_ALT" -parent ${Datapath}
+  ipgui::add_param $IPINST -name "MUL_IMPL" -parent ${Datapath} -widget comboBox
+  ipgui::add_param $IPINST -name "MUL_LATENCY" -parent ${Datapath}
 
 
 }
@@ -146,6 +155,69 @@ proc validate_PARAM_VALUE.C_S01_AXI_HIGHADDR { PARAM_VALUE.C_S01_AXI_HIGHADDR }
 }
 
 
+proc update_PARAM_VALUE.NTT_DATA_WIDTH { PARAM_VALUE.NTT_DATA_WIDTH } {
+	# Procedure called to update NTT_DATA_WIDTH when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.NTT_DATA_WIDTH { PARAM_VALUE.NTT_DATA_WIDTH } {
+	# Procedure called to validate NTT_DATA_WIDTH
+	return true
+}
+
+proc update_PARAM_VALUE.NTT_Q { PARAM_VALUE.NTT_Q } {
+	# Procedure called to update NTT_Q when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.NTT_Q { PARAM_VALUE.NTT_Q } {
+	# Procedure called to validate NTT_Q
+	return true
+}
+
+proc update_PARAM_VALUE.NTT_OMEGA { PARAM_VALUE.NTT_OMEGA } {
+	# Procedure called to update NTT_OMEGA when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.NTT_OMEGA { PARAM_VALUE.NTT_OMEGA } {
+	# Procedure called to validate NTT_OMEGA
+	return true
+}
+
+proc update_PARAM_VALUE.NTT_Q_ALT { PARAM_VALUE.NTT_Q_ALT } {
+	# Procedure called to update NTT_Q_ALT when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.NTT_Q_ALT { PARAM_VALUE.NTT_Q_ALT } {
+	# Procedure called to validate NTT_Q_ALT
+	return true
+}
+
+proc update_PARAM_VALUE.NTT_OMEGA_ALT { PARAM_VALUE.NTT_OMEGA_ALT } {
+	# Procedure called to update NTT_OMEGA_ALT when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.NTT_OMEGA_ALT { PARAM_VALUE.NTT_OMEGA_ALT } {
+	# Procedure called to validate NTT_OMEGA_ALT
+	return true
+}
+
+proc update_PARAM_VALUE.MUL_IMPL { PARAM_VALUE.MUL_IMPL } {
+	# Procedure called to update MUL_IMPL when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.MUL_IMPL { PARAM_VALUE.MUL_IMPL } {
+	# Procedure called to validate MUL_IMPL
+	return true
+}
+
+proc update_PARAM_VALUE.MUL_LATENCY { PARAM_VALUE.MUL_LATENCY } {
+	# Procedure called to update MUL_LATENCY when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.MUL_LATENCY { PARAM_VALUE.MUL_LATENCY } {
+	# Procedure called to validate MUL_LATENCY
+	return true
+}
+
 proc update_MODELPARAM_VALUE.C_S00_AXI_DATA_WIDTH { MODELPARAM_VALUE.C_S00_AXI_DATA_WIDTH PARAM_VALUE.C_S00_AXI_DATA_WIDTH } {
 	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
 	set_property value [get_property value ${PARAM_VALUE.C_S00_AXI_DATA_WIDTH}] ${MODELPARAM_VALUE.C_S00_AXI_DATA_WIDTH}
@@ -196,3 +268,37 @@ proc update_MODELPARAM_VALUE.C_S01_AXI_BUSER_WIDTH { MODELPARAM_VALUE.C_S01_AXI_
 	set_property value [get_property value ${PARAM_VALUE.C_S01_AXI_BUSER_WIDTH}] ${MODELPARAM_VALUE.C_S01_AXI_BUSER_WIDTH}
 }
 
+proc update_MODELPARAM_VALUE.NTT_DATA_WIDTH { MODELPARAM_VALUE.NTT_DATA_WIDTH PARAM_VALUE.NTT_DATA_WIDTH } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.NTT_DATA_WIDTH}] ${MODELPARAM_VALUE.NTT_DATA_WIDTH}
+}
+
+proc update_MODELPARAM_VALUE.NTT_Q { MODELPARAM_VALUE.NTT_Q PARAM_VALUE.NTT_Q } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.NTT_Q}] ${MODELPARAM_VALUE.NTT_Q}
+}
+
+proc update_MODELPARAM_VALUE.NTT_OMEGA { MODELPARAM_VALUE.NTT_OMEGA PARAM_VALUE.NTT_OMEGA } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.NTT_OMEGA}] ${MODELPARAM_VALUE.NTT_OMEGA}
+}
+
+proc update_MODELPARAM_VALUE.NTT_Q_ALT { MODELPARAM_VALUE.NTT_Q_ALT PARAM_VALUE.NTT_Q_ALT } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.NTT_Q_ALT}] ${MODELPARAM_VALUE.NTT_Q_ALT}
+}
+
+proc update_MODELPARAM_VALUE.NTT_OMEGA_ALT { MODELPARAM_VALUE.NTT_OMEGA_ALT PARAM_VALUE.NTT_OMEGA_ALT } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.NTT_OMEGA_ALT}] ${MODELPARAM_VALUE.NTT_OMEGA_ALT}
+}
+
+proc update_MODELPARAM_VALUE.MUL_IMPL { MODELPARAM_VALUE.MUL_IMPL PARAM_VALUE.MUL_IMPL } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.MUL_IMPL}] ${MODELPARAM_VALUE.MUL_IMPL}
+}
+
+proc update_MODELPARAM_VALUE.MUL_LATENCY { MODELPARAM_VALUE.MUL_LATENCY PARAM_VALUE.MUL_LATENCY } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.MUL_LATENCY}] ${MODELPARAM_VALUE.MUL_LATENCY}
+}
@@ -1,18 +1,24 @@
 `timescale 1ns / 1ps
 
-module BRAM_256x12 (
+// 256 x 12-bit true dual-port RAM. BANKS > 1 stacks that many polynomials,
+// the bank index forms the upper address bits. WIDTH widens the words (23 for Dilithium).
+module BRAM_256x12 #(
+    parameter int BANKS = 1,
+    parameter int WIDTH = 12,
+    localparam int AW   = 8 + $clog2(BANKS)
+)(
     input  logic clk,
     // Port A
-    input  logic [7:0] addr_a,
-    input  logic [11:0] din_a,
-    output logic [11:0] dout_a,
+    input  logic [AW-1:0] addr_a,
+    input  logic [WIDTH-1:0] din_a,
+    output logic [WIDTH-1:0] dout_a,
     input  logic we_a,
     input  logic en_a,
 
     // Port B
-    input  logic [7:0] addr_b,
-    input  logic [11:0] din_b,
-    output logic [11:0] dout_b,
+    input  logic [AW-1:0] addr_b,
+    input  logic [WIDTH-1:0] din_b,
+    output logic [WIDTH-1:0] dout_b,
     input  logic we_b,
     input  logic en_b
 );
@@ -20,7 +26,7 @@ module BRAM_256x12 (
     // ------------------------------------------------------------------------
     // Memory declaration - Vivado will infer block RAM from this
     // ------------------------------------------------------------------------
-    logic [11:0] mem [0:255];
+    logic [WIDTH-1:0] mem [0:256*BANKS-1];
 
     // Port A (Read/Write)
     always_ff @(posedge clk) begin
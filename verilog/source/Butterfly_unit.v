@@ -1,120 +1,141 @@
 `timescale 1ns / 1ps
 
-module Butterfly_unit (
-    IN_1,IN_2, //12-BIT INPUTS
+module Butterfly_unit #(
+    parameter MUL_IMPL = "SHIFT_ADD", //Mod_mul MICROARCHITECTURE
+    parameter LATENCY  = 3,           //Mod_mul PIPELINE DEPTH = BUTTERFLY LATENCY
+    parameter WIDTH    = 12,          //COEFFICIENT WIDTH
+    parameter Q        = 3329,        //MODULUS
+    parameter Q_ALT    = 0            //DUAL-MODE SECOND MODULUS, SELECTED BY alt
+)(
+    IN_1,IN_2, //WIDTH-BIT INPUTS
     twiddle, //TWIDDLE FACTOR
     clk,r, //CLOCK AND RESET FOR MULTIPLIER AND FLIP FLOPS
     inverse,valid_in, valid_out, //PIPELINE CONTROL SIGNALS FOR MULTIPLIER AND BIT FOR INTT
+    alt, //DUAL-MODE: WORK MOD Q_ALT, HELD FOR THE WHOLE TRANSFORM
     
-    U_OUT,V_OUT // 12-BIT OUTPUTS    
+    U_OUT,V_OUT // WIDTH-BIT OUTPUTS    
     );
     
     input wire clk, r;
-    input wire[11:0] IN_1, IN_2, twiddle;
+    input wire[WIDTH-1:0] IN_1, IN_2, twiddle;
     input wire valid_in, inverse;
+    input wire alt;
     
     output wire valid_out;
     
+    integer i;
+    
     // Pipeline inverse flag to stay in sync
-    reg [2:0] inverse_pipe;
-    wire transition = inverse_pipe[1] != inverse_pipe[2];
+    reg [LATENCY-1:0] inverse_pipe;
     
     always @(posedge clk or posedge r) begin
         if (r)
-            inverse_pipe <= 3'b000;
+            inverse_pipe <= 0;
+        else if (LATENCY == 1)
+            inverse_pipe <= inverse;
         else
-            inverse_pipe <= {inverse_pipe[1:0], inverse};
+            inverse_pipe <= {inverse_pipe, inverse};
     end
-    wire inverse_synced = inverse_pipe[2];
+    wire inverse_synced = inverse_pipe[LATENCY-1];
     
-    wire[11:0] U, V;
+    wire[WIDTH-1:0] U, V;
     
     //PIPELINE IN_1 TO SYNC WITH MULTIPLIER OUTPUT
-    wire[11:0] IN_1_pipelined;
-    reg[11:0] delay_pipe [0:2];
+    wire[WIDTH-1:0] IN_1_pipelined;
+    reg[WIDTH-1:0] delay_pipe [0:LATENCY-1];
 
     always @(posedge clk, posedge r) begin
         if (r) begin
-            delay_pipe[0] <= 0;
-            delay_pipe[1] <= 0;
-            delay_pipe[2] <= 0;
+            for (i = 0; i < LATENCY; i = i + 1)
+                delay_pipe[i] <= 0;
         end
         else begin
             delay_pipe[0] <= IN_1;
-            delay_pipe[1] <= delay_pipe[0];
-            delay_pipe[2] <= delay_pipe[1];
+            for (i = 1; i < LATENCY; i = i + 1)
+                delay_pipe[i] <= delay_pipe[i-1];
         end
     end
     
-    assign IN_1_pipelined = delay_pipe[2];
+    assign IN_1_pipelined = delay_pipe[LATENCY-1];
     //DECIDE INPUT BASED ON INVERSE CONTROL SIGNAL
-    wire[11:0] IN_1_final;
+    wire[WIDTH-1:0] IN_1_final;
     assign IN_1_final = inverse_synced ? IN_1 : IN_1_pipelined; //DIRECT INPUT IF INTT
     
     
-    wire[11:0] mul_in; //MULTIPLIER INPUT
+    wire[WIDTH-1:0] mul_in; //MULTIPLIER INPUT
     assign mul_in = inverse_synced ? sub.C : IN_2;
     
-    wire[11:0] mul_out;//MULTIPLIER OUTPUT
+    wire[WIDTH-1:0] mul_out;//MULTIPLIER OUTPUT
     // Instantiate the modular multiplication module
-    Mod_mul mul (
+    Mod_mul #(
+        .IMPL(MUL_IMPL),
+        .LATENCY(LATENCY),
+        .WIDTH(WIDTH),
+        .Q(Q),
+        .Q_ALT(Q_ALT)
+    ) mul (
         .valid_in(valid_in),
         .valid_out(valid_out),
         .clk(clk),
         .r(r),
         .A(mul_in),
         .B(twiddle),
+        .alt(alt),
         .OUT(mul_out)
     );
     
     // Instantiate the modular addition module
     //ADDER INPUT 
-    wire[11:0] add_sub_in;
+    wire[WIDTH-1:0] add_sub_in;
     assign add_sub_in = inverse_synced ? IN_2 : mul_out;
     
-    Mod_add add (
+    Mod_add #(.WIDTH(WIDTH), .Q(Q), .Q_ALT(Q_ALT)) add (
         .A(IN_1_final),
         .B(add_sub_in),
+        .alt(alt),
         .C(U)
     );
 
     // Instantiate the modular subtraction module
-    Mod_sub sub (
+    Mod_sub #(.WIDTH(WIDTH), .Q(Q), .Q_ALT(Q_ALT)) sub (
         .A(IN_1_final),
         .B(add_sub_in),
+        .alt(alt),
         .C(V)
     );
     //FINAL OUTPUTS
-    output wire[11:0] U_OUT, V_OUT;
+    output wire[WIDTH-1:0] U_OUT, V_OUT;
+    
+    //(q-1)/2: x/2 mod q FOR ODD x IS (q-1)/2 + (x+1)/2 (KYBER: 1664)
+    wire[WIDTH-1:0] q_half = ((Q_ALT != 0) && alt) ? (Q_ALT - 1) / 2 : (Q - 1) / 2;
     
     //conditional right shift for odd numbers (normal right shift outputs wrong results)
-    wire[11:0] U_shift;
+    wire[WIDTH-1:0] U_shift;
     
     //check if U is odd
-    assign U_shift = U[0] ? ((11'd1664) + ((U + 1'b1) >> 1'b1)) : U >> 1'b1;
+    assign U_shift = U[0] ? (q_half + ((U + 1'b1) >> 1'b1)) : U >> 1'b1;
     
     // Delay adder output (U) in iNTT mode to match multiplier latency
-    reg [11:0] U_pipe [0:2];
+    reg [WIDTH-1:0] U_pipe [0:LATENCY-1];
     always @(posedge clk or posedge r) begin
         if (r) begin
-            U_pipe[0] <= 0;
-            U_pipe[1] <= 0;
-            U_pipe[2] <= 0;
+            for (i = 0; i < LATENCY; i = i + 1)
+                U_pipe[i] <= 0;
         end
         else begin
             U_pipe[0] <= U_shift;
-            U_pipe[1] <= U_pipe[0];
-            U_pipe[2] <= U_pipe[1];
+            for (i = 1; i < LATENCY; i = i + 1)
+                U_pipe[i] <= U_pipe[i-1];
         end
     end
     
-    assign U_OUT = inverse_synced ? (U_pipe[2]) : U;
+    assign U_OUT = inverse_synced ? (U_pipe[LATENCY-1]) : U;
     
     //conditional right shift for odd numbers (normal right shift outputs wrong results)
-    wire[11:0] V_shift;
+    wire[WIDTH-1:0] V_shift;
     
     //check if U is odd
-    assign V_shift = mul_out[0] ? ((11'd1664) + ((mul_out + 1'b1) >> 1'b1)) : mul_out >> 1'b1;
+    assign V_shift = mul_out[0] ? (q_half + ((mul_out + 1'b1) >> 1'b1)) : mul_out >> 1'b1;
     
     assign V_OUT = inverse_synced ? (V_shift) : V;
 
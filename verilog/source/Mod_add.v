@@ -14,29 +14,37 @@
 // Dependencies: 
 // 
 // Revision:
+// Revision 0.02 - Width and modulus parameters, optional runtime second modulus
 // Revision 0.01 - File Created
 // Additional Comments:
 // 
 //////////////////////////////////////////////////////////////////////////////////
 
 
-module Mod_add(
+//OUT = A+B mod q, q = Q OR (DUAL-MODE BUILDS, Q_ALT != 0) Q_ALT WHEN alt IS SET
+module Mod_add #(
+        parameter WIDTH = 12,   //COEFFICIENT WIDTH, q < 2^WIDTH
+        parameter Q     = 3329, //KYBER module
+        parameter Q_ALT = 0     //SECOND MODULUS, 0 = SINGLE-MODE (alt IGNORED)
+    )(
         A,B,
+        alt,
         C
     );
     
-    input wire[11:0] A,B;
-    output wire[11:0] C;
+    input wire[WIDTH-1:0] A,B;
+    input wire alt;
+    output wire[WIDTH-1:0] C;
     
-    localparam q = 3329; //KYBER module
+    wire[WIDTH-1:0] q = ((Q_ALT != 0) && alt) ? Q_ALT : Q;
     
     
     wire is_bigger;
-    wire[12:0] sum  = A + B;
-    wire[11:0] diff = sum - q;
+    wire[WIDTH:0] sum  = A + B;
+    wire[WIDTH-1:0] diff = sum - q;
     
     assign is_bigger = sum >= q;
     
-    assign C = (is_bigger) ? diff : sum[11:0];
+    assign C = (is_bigger) ? diff : sum[WIDTH-1:0];
     
 endmodule
@@ -14,28 +14,36 @@
 // Dependencies: 
 // 
 // Revision:
+// Revision 0.02 - Width and modulus parameters, optional runtime second modulus
 // Revision 0.01 - File Created
 // Additional Comments:
 // 
 //////////////////////////////////////////////////////////////////////////////////
 
 
-module Mod_sub(
+//OUT = A-B mod q, q = Q OR (DUAL-MODE BUILDS, Q_ALT != 0) Q_ALT WHEN alt IS SET
+module Mod_sub #(
+        parameter WIDTH = 12,   //COEFFICIENT WIDTH, q < 2^WIDTH
+        parameter Q     = 3329, //KYBER module
+        parameter Q_ALT = 0     //SECOND MODULUS, 0 = SINGLE-MODE (alt IGNORED)
+    )(
         A,B,
+        alt,
         C
     );
     
-    input wire[11:0] A,B;
-    output wire[11:0] C;
+    input wire[WIDTH-1:0] A,B;
+    input wire alt;
+    output wire[WIDTH-1:0] C;
     
-    localparam q = 3329; //KYBER module
+    wire[WIDTH-1:0] q = ((Q_ALT != 0) && alt) ? Q_ALT : Q;
     
     
-    wire is_bigger;
-    wire signed[12:0] diff  = A - B;
-    wire[11:0] sum = diff + q;
+    wire is_smaller;
+    wire signed[WIDTH:0] diff  = A - B;
+    wire[WIDTH-1:0] sum = diff + q;
     
     assign is_smaller = diff < 0;
     
-    assign C = (is_smaller) ? sum[11:0] : diff;
+    assign C = (is_smaller) ? sum[WIDTH-1:0] : diff[WIDTH-1:0];
 endmodule
\ No newline at end of file
@@ -44,7 +44,14 @@ module NTT_Controller #(
     output logic                  valid_in,
     input  logic                  valid_out,
     input  logic [DATA_WIDTH-1:0] butterfly_u,
-    input  logic [DATA_WIDTH-1:0] butterfly_v
+    input  logic [DATA_WIDTH-1:0] butterfly_v,
+
+    // Status for the performance counters
+    output logic                  status_busy,      // not IDLE
+    output logic                  status_pipeline,  // PIPELINE (stage in status_stage)
+    output logic                  status_flush,     // FLUSH: draining the butterfly
+    output logic                  status_intt_wait, // INTT_WAIT: inverse warm-up
+    output logic [$clog2(N)-1:0]  status_stage
 );
 
     // Derived params
@@ -388,4 +395,10 @@ module NTT_Controller #(
 
     assign done = (state == DONE);
 
+    assign status_busy      = (state != IDLE);
+    assign status_pipeline  = (state == PIPELINE);
+    assign status_flush     = (state == FLUSH);
+    assign status_intt_wait = (state == INTT_WAIT);
+    assign status_stage     = stage;
+
 endmodule
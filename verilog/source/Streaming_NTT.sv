@@ -0,0 +1,77 @@
+`timescale 1ns / 1ps
+
+// FULLY PIPELINED STREAMING NTT/INTT, N = 256
+// Generalises Full_NTT/Full_iNTT: LOGN Streaming_NTT_stage instances joined by delay
+// lines, P coefficients per clock, a new polynomial accepted every N/P cycles.
+// Each stage owns its twiddle ROM, so all stages work on different polynomials at once.
+//
+// Coefficients go in and come out in natural order, grouped P per beat:
+// beat c carries coefficients c*P .. c*P+P-1 (lane 0 = lowest index).
+// Results match ntt_standard(a, 256, 910) / intt_standard(a, 256, 3040) in ntt.c.
+module Streaming_NTT #(
+    parameter int N          = 256,     // twiddle_ROM contents are generated for N = 256
+    parameter int P          = 1,       // samples per clock, power of 2, 1 .. N/2
+    parameter bit INVERSE    = 1'b0,    // 0 = NTT, 1 = INTT
+    parameter int DATA_WIDTH = 12,      // at least the bit length of Q
+    parameter longint Q      = 3329,    // modulus of the butterflies and twiddle ROMs
+    parameter longint OMEGA  = 910,     // order N/2 mod Q (Dilithium: 3602218, DATA_WIDTH 23)
+    parameter     MUL_IMPL    = "SHIFT_ADD", // Mod_mul microarchitecture
+    parameter int MUL_LATENCY = 3            // Mod_mul/Butterfly_unit latency
+)(
+    input  logic                  clk,
+    input  logic                  rst,
+    input  logic                  valid_in,
+    input  logic [DATA_WIDTH-1:0] data_in  [0:P-1],
+    output logic                  valid_out,
+    output logic [DATA_WIDTH-1:0] data_out [0:P-1]
+);
+
+    localparam int LOGN = $clog2(N);
+
+    // coefficients must fit DATA_WIDTH
+    if ((64'd1 << DATA_WIDTH) < Q) begin : width_check
+        $error("Streaming_NTT: DATA_WIDTH %0d cannot hold Q = %0d", DATA_WIDTH, Q);
+    end
+
+    // stage s drives link s+1
+    wire                  link_valid [0:LOGN];
+    wire [DATA_WIDTH-1:0] link_data  [0:LOGN][0:P-1];
+
+    genvar s, l;
+    generate
+        assign link_valid[0] = valid_in;
+        for (l = 0; l < P; l++) begin : in_lane
+            assign link_data[0][l] = data_in[l];
+        end
+
+        for (s = 0; s < LOGN; s++) begin : stage
+            // NTT distances N/2 .. 1, INTT distances 1 .. N/2 (same loops as ntt.c)
+            localparam int LEN = INVERSE ? (1 << s) : (N >> (s + 1));
+
+            Streaming_NTT_stage #(
+                .N(N),
+                .P(P),
+                .LEN(LEN),
+                .INVERSE(INVERSE),
+                .DATA_WIDTH(DATA_WIDTH),
+                .Q(Q),
+                .OMEGA(OMEGA),
+                .MUL_IMPL(MUL_IMPL),
+                .MUL_LATENCY(MUL_LATENCY)
+            ) st (
+                .clk(clk),
+                .rst(rst),
+                .valid_in(link_valid[s]),
+                .data_in(link_data[s]),
+                .valid_out(link_valid[s+1]),
+                .data_out(link_data[s+1])
+            );
+        end
+
+        assign valid_out = link_valid[LOGN];
+        for (l = 0; l < P; l++) begin : out_lane
+            assign data_out[l] = link_data[LOGN][l];
+        end
+    endgenerate
+
+endmodule
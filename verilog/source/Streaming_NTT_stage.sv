@@ -0,0 +1,253 @@
+`timescale 1ns / 1ps
+
+// ONE STAGE OF THE STREAMING NTT/INTT PIPELINE
+// Pairs coefficients at distance LEN, exactly like one 'len' iteration of
+// ntt_standard()/intt_standard(). Data enters and leaves in natural order, P per clock.
+//
+//  LEN >= P : pairs live in the same lane, D = LEN/P cycles apart.
+//             First D cycles of every 2D block are buffered, the next D cycles meet
+//             their partner in the butterfly. U leaves immediately, V waits D cycles,
+//             so the output stream stays contiguous. With D > 1 + MUL_LATENCY the
+//             buffer is a single delay-feedback (SDF) loop shared by the buffered inputs
+//             and the waiting V results (D + 1 + MUL_LATENCY words per lane), shorter
+//             stages use separate input and output delay lines (2D words).
+//  LEN <  P : pairs live in the same clock cycle (lanes l and l+LEN), no delay lines.
+//
+// A polynomial must be presented in N/P consecutive valid cycles; gaps between
+// polynomials are allowed. Latency = 1 (ROM) + MUL_LATENCY (Butterfly_unit) + D.
+module Streaming_NTT_stage #(
+    parameter int N          = 256,
+    parameter int P          = 1,       // samples per clock
+    parameter int LEN        = 128,     // butterfly distance of this stage
+    parameter bit INVERSE    = 1'b0,    // 0 = NTT (CT butterfly), 1 = INTT (GS butterfly)
+    parameter int DATA_WIDTH = 12,      // at least the bit length of Q
+    parameter longint Q      = 3329,
+    parameter longint OMEGA  = 910,     // order N/2 mod Q, see twiddle_ROM
+    parameter     MUL_IMPL    = "SHIFT_ADD", // Mod_mul microarchitecture
+    parameter int MUL_LATENCY = 3            // Mod_mul/Butterfly_unit latency
+)(
+    input  logic                  clk,
+    input  logic                  rst,
+    input  logic                  valid_in,
+    input  logic [DATA_WIDTH-1:0] data_in  [0:P-1],
+    output logic                  valid_out,
+    output logic [DATA_WIDTH-1:0] data_out [0:P-1]
+);
+
+    localparam int STEP     = N / (2 * LEN);           // twiddle index stride
+    localparam int ROM_BASE = INVERSE ? (N / 2) : 0;   // twiddle_ROM: NTT half, then INTT half
+    localparam int CYCLES   = N / P;                   // cycles per polynomial
+    localparam int CNT_W    = (CYCLES <= 2) ? 1 : $clog2(CYCLES);
+
+    // position of the current input beat inside the polynomial
+    logic [CNT_W-1:0] cnt;
+
+    always_ff @(posedge clk, posedge rst) begin
+        if (rst)
+            cnt <= '0;
+        else if (valid_in)
+            cnt <= cnt + 1'b1;
+    end
+
+    wire  [DATA_WIDTH-1:0] bf_u [0:P-1];
+    wire  [DATA_WIDTH-1:0] bf_v [0:P-1];
+    wire  [P-1:0]          bf_valid_out;
+    logic                  bf_valid;
+
+    genvar l;
+    generate
+        if (LEN >= P) begin : delay_path
+            localparam int D = LEN / P;
+            // B operand in to U/V out: operand register + Mod_mul pipeline
+            localparam int L = 1 + MUL_LATENCY;
+            // a feedback buffer needs the butterfly to return V before the next block
+            // starts writing, i.e. D > L; shorter stages keep the two delay lines
+            localparam bit SDF = D > L;
+
+            // first half of a 2D block is buffered, second half is processed
+            wire second_half = cnt[$clog2(D)];
+
+            always_ff @(posedge clk, posedge rst) begin
+                if (rst) bf_valid <= 1'b0;
+                else     bf_valid <= valid_in && second_half;
+            end
+
+            // V results leave D cycles behind their U partners
+            logic vv_dl [0:D-1];
+
+            always_ff @(posedge clk, posedge rst) begin
+                integer k;
+                if (rst) begin
+                    for (k = 0; k < D; k++) vv_dl[k] <= 1'b0;
+                end else begin
+                    vv_dl[0] <= bf_valid_out[0];
+                    for (k = 1; k < D; k++) vv_dl[k] <= vv_dl[k-1];
+                end
+            end
+
+            for (l = 0; l < P; l++) begin : lane
+                wire  [DATA_WIDTH-1:0] a_op;    // first-half partner of the current input
+                wire  [DATA_WIDTH-1:0] v_del;   // V result, D cycles after the butterfly
+                logic [DATA_WIDTH-1:0] in1, in2, tw;
+                logic [7:0] tw_addr;
+
+                if (SDF) begin : sdf
+                    // Single-path delay feedback: one buffer holds the first half of a
+                    // block until its partner arrives, then the V results of that block
+                    // until they are due at the output. The buffer is D - L long, the
+                    // L cycles of the butterfly are made up by the input and output
+                    // registers, so inputs and V results never compete for a write slot.
+                    // D + L words per lane instead of 2D for the feed-forward lines.
+                    logic [DATA_WIDTH-1:0] x_dl [0:L-1];     // input, L cycles
+                    logic [DATA_WIDTH-1:0] fb   [0:D-L-1];   // feedback buffer
+                    logic [DATA_WIDTH-1:0] o_dl [0:L-1];     // buffer output, L cycles
+
+                    always_ff @(posedge clk) begin
+                        integer k;
+                        x_dl[0] <= data_in[l];
+                        fb[0]   <= bf_valid_out[0] ? bf_v[l] : x_dl[L-1];
+                        o_dl[0] <= fb[D-L-1];
+                        for (k = 1; k < L; k++) begin
+                            x_dl[k] <= x_dl[k-1];
+                            o_dl[k] <= o_dl[k-1];
+                        end
+                        for (k = 1; k < D - L; k++) fb[k] <= fb[k-1];
+                    end
+
+                    assign a_op  = fb[D-L-1];
+                    assign v_del = o_dl[L-1];
+                end
+                else begin : mdc
+                    logic [DATA_WIDTH-1:0] a_dl [0:D-1];   // input delay line
+                    logic [DATA_WIDTH-1:0] v_dl [0:D-1];   // output delay line
+
+                    always_ff @(posedge clk) begin
+                        integer k;
+                        a_dl[0] <= data_in[l];
+                        v_dl[0] <= bf_v[l];
+                        for (k = 1; k < D; k++) begin
+                            a_dl[k] <= a_dl[k-1];
+                            v_dl[k] <= v_dl[k-1];
+                        end
+                    end
+
+                    assign a_op  = a_dl[D-1];
+                    assign v_del = v_dl[D-1];
+                end
+
+                // same twiddle index as zetas[j * step] in ntt.c, j = position inside the half block
+                assign tw_addr = ROM_BASE + (((cnt % D) * P + l) * STEP);
+
+                twiddle_ROM #(
+                    .WIDTH(DATA_WIDTH),
+                    .Q(Q),
+                    .OMEGA(OMEGA)
+                ) rom (
+                    .clk(clk),
+                    .addr(tw_addr),
+                    .alt(1'b0),
+                    .dout(tw)
+                );
+
+                // register operands so they line up with the synchronous ROM output
+                always_ff @(posedge clk, posedge rst) begin
+                    if (rst) begin
+                        in1 <= '0;
+                        in2 <= '0;
+                    end else begin
+                        in1 <= a_op;
+                        in2 <= data_in[l];
+                    end
+                end
+
+                Butterfly_unit #(
+                    .MUL_IMPL(MUL_IMPL),
+                    .LATENCY(MUL_LATENCY),
+                    .WIDTH(DATA_WIDTH),
+                    .Q(Q)
+                ) butterfly (
+                    .IN_1(in1),
+                    .IN_2(in2),
+                    .twiddle(tw),
+                    .clk(clk),
+                    .r(rst),
+                    .inverse(INVERSE),
+                    .valid_in(bf_valid),
+                    .valid_out(bf_valid_out[l]),
+                    .alt(1'b0),
+                    .U_OUT(bf_u[l]),
+                    .V_OUT(bf_v[l])
+                );
+
+                assign data_out[l] = bf_valid_out[0] ? bf_u[l] : v_del;
+            end
+
+            assign valid_out = bf_valid_out[0] | vv_dl[D-1];
+        end
+        else begin : lane_path
+            always_ff @(posedge clk, posedge rst) begin
+                if (rst) bf_valid <= 1'b0;
+                else     bf_valid <= valid_in;
+            end
+
+            for (l = 0; l < P; l++) begin : lane
+                if ((l % (2 * LEN)) < LEN) begin : top
+                    logic [DATA_WIDTH-1:0] in1, in2, tw;
+
+                    // twiddle is fixed per lane pair: j = l mod LEN
+                    twiddle_ROM #(
+                        .WIDTH(DATA_WIDTH),
+                        .Q(Q),
+                        .OMEGA(OMEGA)
+                    ) rom (
+                        .clk(clk),
+                        .addr(8'(ROM_BASE + (l % LEN) * STEP)),
+                        .alt(1'b0),
+                        .dout(tw)
+                    );
+
+                    always_ff @(posedge clk, posedge rst) begin
+                        if (rst) begin
+                            in1 <= '0;
+                            in2 <= '0;
+                        end else begin
+                            in1 <= data_in[l];
+                            in2 <= data_in[l + LEN];
+                        end
+                    end
+
+                    Butterfly_unit #(
+                        .MUL_IMPL(MUL_IMPL),
+                        .LATENCY(MUL_LATENCY),
+                        .WIDTH(DATA_WIDTH),
+                        .Q(Q)
+                    ) butterfly (
+                        .IN_1(in1),
+                        .IN_2(in2),
+                        .twiddle(tw),
+                        .clk(clk),
+                        .r(rst),
+                        .inverse(INVERSE),
+                        .valid_in(bf_valid),
+                        .valid_out(bf_valid_out[l]),
+                        .alt(1'b0),
+                        .U_OUT(bf_u[l]),
+                        .V_OUT(bf_v[l])
+                    );
+
+                    assign data_out[l] = bf_u[l];
+                end
+                else begin : bottom
+                    // V output of the partner lane
+                    assign bf_u[l]         = '0;
+                    assign bf_v[l]         = '0;
+                    assign bf_valid_out[l] = 1'b0;
+                    assign data_out[l]     = bf_v[l - LEN];
+                end
+            end
+
+            assign valid_out = bf_valid_out[0];
+        end
+    endgenerate
+
+endmodule
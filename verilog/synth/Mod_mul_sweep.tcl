@@ -0,0 +1,59 @@
+# Out-of-context area/timing sweep of Mod_mul: every IMPL at LATENCY 1..5 on the
+# Zynq-7020 of the PS_PL_platform design (xc7z020clg400-1).
+#
+#   cd verilog/synth && vivado -mode batch -source Mod_mul_sweep.tcl [-tclargs <period_ns> [place]]
+#
+# Each point is synthesized (and with "place" also placed and routed) against a clock of
+# <period_ns> (default 4.0, tighter than any variant closes, so WNS measures the critical
+# path); Fmax = 1000 / (period - WNS). Results go to Mod_mul_sweep.csv and, as a table,
+# to Mod_mul_sweep.md in this directory. The chosen point goes into the packaged IP
+# through its MUL_IMPL / MUL_LATENCY parameters ("NTT Datapath" page of AXI_NTT_UNIT).
+
+set part    xc7z020clg400-1
+set period  [expr {$argc > 0 ? [lindex $argv 0] : 4.0}]
+set route   [expr {$argc > 1 && [lindex $argv 1] eq "place"}]
+set impls   {SHIFT_ADD BARRETT MONTGOMERY BOOTH GENERIC}
+set lats    {1 2 3 4 5}
+set here    [file dirname [file normalize [info script]]]
+set src     [file join $here .. source]
+
+set csv [open [file join $here Mod_mul_sweep.csv] w]
+puts $csv "impl,latency,lut,ff,dsp,carry4,wns_ns,fmax_mhz"
+set rows {}
+
+foreach impl $impls {
+    foreach lat $lats {
+        create_project -in_memory -part $part
+        read_verilog [file join $src Mod_mul.v]
+        synth_design -top Mod_mul -part $part -mode out_of_context \
+            -generic "IMPL=\"$impl\"" -generic LATENCY=$lat
+        create_clock -name clk -period $period [get_ports clk]
+        if {$route} {
+            opt_design
+            place_design
+            route_design
+        }
+
+        set lut [llength [get_cells -hier -filter {PRIMITIVE_GROUP == LUT}]]
+        set ff  [llength [get_cells -hier -filter {PRIMITIVE_GROUP == FLOP_LATCH}]]
+        set dsp [llength [get_cells -hier -filter {PRIMITIVE_GROUP == ARITHMETIC && REF_NAME =~ DSP*}]]
+        set c4  [llength [get_cells -hier -filter {REF_NAME == CARRY4}]]
+        set wns [get_property SLACK [get_timing_paths -delay_type max -max_paths 1]]
+        set fmax [format %.1f [expr {1000.0 / ($period - $wns)}]]
+
+        puts $csv "$impl,$lat,$lut,$ff,$dsp,$c4,$wns,$fmax"
+        flush $csv
+        lappend rows [list $impl $lat $lut $ff $dsp $c4 $wns $fmax]
+        close_project
+    }
+}
+close $csv
+
+set md [open [file join $here Mod_mul_sweep.md] w]
+puts $md "Mod_mul on $part, [expr {$route ? {placed and routed} : {synthesis only}}], clock $period ns, [version -short]\n"
+puts $md "| IMPL | LATENCY | LUT | FF | DSP48 | CARRY4 | WNS (ns) | Fmax (MHz) |"
+puts $md "|------|---------|-----|----|-------|--------|----------|------------|"
+foreach r $rows {
+    puts $md "| [join $r { | }] |"
+}
+close $md
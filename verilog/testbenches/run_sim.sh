@@ -0,0 +1,88 @@
+#!/bin/sh
+# Compile and run one testbench against verilog/source with whichever simulator is
+# installed (Vivado xsim, Icarus Verilog >= 12, Verilator >= 5 with --timing).
+# The transcript goes to logs/<testbench>.log next to this script; the exit status is
+# non-zero when the testbench prints FAILED / MISMATCH / ERROR ($error) or the tools fail.
+#
+#   ./run_sim.sh tb_Streaming_NTT
+#   SIM=xsim ./run_sim.sh tb_Mod_mul_exhaustive +define+QUICK
+#   ./run_sim.sh tb_NTT_datapath_params -- VECTOR_DIR=/tmp/vectors
+#
+# Arguments after the testbench name are passed to the compiler (+define+...), a
+# "--" switches to NAME=VALUE top-level parameter overrides.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+SRC="$HERE/../source"
+IPHDL="$HERE/../ip_repo/AXI_NTT_unit/AXI_NTT_UNIT_1.0/hdl"
+TB=$1
+[ -n "$TB" ] || { echo "usage: $0 <testbench> [+define+X ...] [-- NAME=VALUE ...]"; exit 2; }
+shift
+
+DEFINES=""
+PARAMS=""
+while [ $# -gt 0 ]; do
+    if [ "$1" = "--" ]; then shift; PARAMS="$*"; break; fi
+    DEFINES="$DEFINES $1"
+    shift
+done
+
+# the legacy 8-point prototypes (Full_NTT/Full_iNTT) use a Butterfly_unit port that no longer exists
+# plus the AXI-Lite control slave of the packaged IP for the register-level tests
+SOURCES="$(ls "$SRC"/*.v "$SRC"/*.sv | grep -v "/Full_") $IPHDL/AXI_NTT_UNIT_v1_0_S00_AXI.v"
+TBFILE=$(ls "$HERE/$TB.sv" "$HERE/$TB.v" 2>/dev/null | head -n 1)
+[ -n "$TBFILE" ] || { echo "no testbench $TB in $HERE"; exit 2; }
+
+if [ -z "$SIM" ]; then
+    for s in xsim iverilog verilator; do
+        if command -v "$s" >/dev/null 2>&1; then SIM=$s; break; fi
+    done
+fi
+[ -n "$SIM" ] || { echo "no simulator found (xsim, iverilog or verilator on PATH)"; exit 2; }
+
+mkdir -p "$HERE/logs"
+LOG="$HERE/logs/$TB.log"
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+run() {
+    case $SIM in
+    xsim)
+        GEN=""
+        for p in $PARAMS; do GEN="$GEN -generic_top $p"; done
+        DEFS=$(echo "$DEFINES" | sed 's/+define+/-d /g')
+        (cd "$WORK" && xvlog -sv -i "$SRC" -i "$HERE" $DEFS $SOURCES "$TBFILE" &&
+         xelab -debug off $GEN "$TB" -s sim && xsim sim -R)
+        ;;
+    iverilog)
+        GEN=""
+        for p in $PARAMS; do GEN="$GEN -P$TB.$p"; done
+        iverilog -g2012 -I "$SRC" -I "$HERE" $DEFINES $GEN -s "$TB" -o "$WORK/sim" $SOURCES "$TBFILE" &&
+        (cd "$HERE" && vvp -n "$WORK/sim")
+        ;;
+    verilator)
+        GEN=""
+        for p in $PARAMS; do GEN="$GEN -G$p"; done
+        verilator --binary --timing -Wno-fatal -I"$SRC" -I"$HERE" $DEFINES $GEN --top-module "$TB" \
+            -Mdir "$WORK" -o sim $SOURCES "$TBFILE" >/dev/null &&
+        (cd "$HERE" && "$WORK/sim")
+        ;;
+    *)
+        echo "unknown simulator $SIM"; return 2
+        ;;
+    esac
+}
+
+echo "$TB: $SIM, $(date)" > "$LOG"
+set +e
+run >> "$LOG" 2>&1
+STATUS=$?
+set -e
+tail -n 5 "$LOG"
+
+if [ $STATUS -ne 0 ] || grep -Eq "FAILED|MISMATCH|ERROR|Error:" "$LOG"; then
+    echo "$TB: FAILED (see $LOG)"
+    exit 1
+fi
+echo "$TB: passed (see $LOG)"
@@ -0,0 +1,47 @@
+#!/bin/sh
+# Runs tb_Streaming_NTT for every stage configuration: P = 1 .. 128 samples per clock and
+# Mod_mul latencies 1 .. 5, so every stage distance D = LEN / P runs once as a
+# delay-feedback loop (D > 1 + MUL_LATENCY), as feed-forward delay lines and as
+# same-cycle lane pairs (LEN < P). The inputs and expected transforms come from
+# gen_ntt_vectors in "Test software C code", built and run into a temporary directory.
+#
+#   ./run_streaming_sweep.sh               all configurations
+#   ./run_streaming_sweep.sh "1 4" "3"     P = 1 and 4, MUL_LATENCY = 3 only
+#
+# Each run keeps its transcript as logs/tb_Streaming_NTT_P<p>_L<latency>.log; the exit
+# status is non-zero if any configuration fails.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+CDIR="$HERE/../../Test software C code"
+PS=${1:-"1 2 4 8 16 32 64 128"}
+LATENCIES=${2:-"1 2 3 4 5"}
+
+VEC=$(mktemp -d)
+trap 'rm -rf "$VEC"' EXIT
+make -s -C "$CDIR" gen_ntt_vectors >/dev/null
+"$CDIR/gen_ntt_vectors" "$VEC" >/dev/null
+
+FAILED=""
+for p in $PS; do
+    for lat in $LATENCIES; do
+        STATUS=0
+        "$HERE/run_sim.sh" tb_Streaming_NTT -- P=$p MUL_LATENCY=$lat VECTOR_DIR=\"$VEC\" >"$VEC/out" || STATUS=$?
+        # run_sim.sh: 1 = testbench or tools failed, 2 = no simulator / usage
+        [ $STATUS -eq 2 ] && { cat "$VEC/out"; exit 2; }
+        if [ $STATUS -eq 0 ]; then
+            echo "P = $p, MUL_LATENCY = $lat: passed"
+        else
+            echo "P = $p, MUL_LATENCY = $lat: FAILED"
+            FAILED="$FAILED P=$p/L=$lat"
+        fi
+        cp "$HERE/logs/tb_Streaming_NTT.log" "$HERE/logs/tb_Streaming_NTT_P${p}_L${lat}.log" 2>/dev/null || true
+    done
+done
+
+if [ -n "$FAILED" ]; then
+    echo "failed:$FAILED"
+    exit 1
+fi
+echo "all streaming configurations passed"
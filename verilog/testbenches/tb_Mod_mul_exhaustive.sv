@@ -0,0 +1,122 @@
+`timescale 1ns / 1ps
+
+// Exhaustive check of every Mod_mul IMPL at several pipeline depths.
+// All Q*Q operand pairs are streamed one per clock (about 11M cycles);
+// each instance compares OUT against A*B % Q, LATENCY cycles after the inputs.
+// Define QUICK to sweep A only over 0..63 while developing.
+module tb_Mod_mul_exhaustive;
+
+    localparam int Q = 3329;
+`ifdef QUICK
+    localparam int A_MAX = 64;
+`else
+    localparam int A_MAX = Q;
+`endif
+
+    logic clk, r;
+    logic [11:0] A, B;
+    logic valid_in;
+
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    // ---------------------------------------------------------------- DUTs
+    localparam int NUM_IMPLS     = 5;
+    localparam int NUM_LATENCIES = 5;   // LATENCY = 1 .. 5
+
+    int errors  [0:NUM_IMPLS-1][0:NUM_LATENCIES-1] = '{default: 0};
+    int checked [0:NUM_IMPLS-1][0:NUM_LATENCIES-1] = '{default: 0};
+
+    genvar gi, gl;
+    generate
+        for (gi = 0; gi < NUM_IMPLS; gi++) begin : impl
+            localparam IMPL = (gi == 0) ? "SHIFT_ADD" :
+                              (gi == 1) ? "BARRETT" :
+                              (gi == 2) ? "MONTGOMERY" :
+                              (gi == 3) ? "BOOTH" : "GENERIC";
+
+            for (gl = 0; gl < NUM_LATENCIES; gl++) begin : lat
+                localparam int L = gl + 1;
+
+                logic        valid_out;
+                logic [11:0] OUT;
+                logic [11:0] exp_pipe [0:L-1];
+
+                Mod_mul #(.IMPL(IMPL), .LATENCY(L)) dut (
+                    .clk(clk),
+                    .r(r),
+                    .A(A),
+                    .B(B),
+                    .alt(1'b0),
+                    .valid_in(valid_in),
+                    .valid_out(valid_out),
+                    .OUT(OUT)
+                );
+
+                // expected result travels next to the DUT pipeline
+                always_ff @(posedge clk) begin
+                    exp_pipe[0] <= (A * B) % Q;
+                    for (int k = 1; k < L; k++) exp_pipe[k] <= exp_pipe[k-1];
+                end
+
+                always @(posedge clk) begin
+                    if (!r && valid_out) begin
+                        checked[gi][gl] <= checked[gi][gl] + 1;
+                        if (OUT !== exp_pipe[L-1]) begin
+                            if (errors[gi][gl] < 5)
+                                $display("ERROR: %s LATENCY=%0d got %0d expected %0d",
+                                         IMPL, L, OUT, exp_pipe[L-1]);
+                            errors[gi][gl] <= errors[gi][gl] + 1;
+                        end
+                    end
+                end
+            end
+        end
+    endgenerate
+
+    // ---------------------------------------------------------------- Stimulus
+    initial begin
+        int total_errors;
+
+        A = 0; B = 0; valid_in = 0;
+        r = 1;
+        repeat (3) @(posedge clk);
+        #1 r = 0;
+
+        for (int a = 0; a < A_MAX; a++) begin
+            for (int b = 0; b < Q; b++) begin
+                @(negedge clk);
+                A = a;
+                B = b;
+                valid_in = 1;
+            end
+            if (a % 256 == 0) $display("A = %0d / %0d", a, A_MAX);
+        end
+
+        @(negedge clk);
+        valid_in = 0;
+        repeat (NUM_LATENCIES + 2) @(posedge clk);
+
+        total_errors = 0;
+        $display("\nIMPL, LATENCY: checked / errors");
+        for (int i = 0; i < NUM_IMPLS; i++)
+            for (int l = 0; l < NUM_LATENCIES; l++) begin
+                $display("%0s, %0d: %0d / %0d",
+                         (i == 0) ? "SHIFT_ADD" : (i == 1) ? "BARRETT" :
+                         (i == 2) ? "MONTGOMERY" : (i == 3) ? "BOOTH" : "GENERIC",
+                         l + 1, checked[i][l], errors[i][l]);
+                total_errors += errors[i][l];
+                if (checked[i][l] != A_MAX * Q) begin
+                    $display("ERROR: expected %0d results", A_MAX * Q);
+                    total_errors++;
+                end
+            end
+
+        if (total_errors == 0)
+            $display("\nTEST PASSED");
+        else
+            $display("\nTEST FAILED: %0d errors", total_errors);
+        $finish;
+    end
+
+endmodule
@@ -1,13 +1,15 @@
 `timescale 1ns/1ps
 
-module tb_ntt_axi_wrapper;
+module tb_NTT_AXI_wrapper;
 
     // Clock and reset
     logic clk = 0;
     logic rst;
     logic start;
     logic mode;
+    logic [2:0] count = 3'd0;   // 0: single polynomial, as before the vector command
     logic done;
+    logic busy, start_dropped;
     
     always begin
         clk = ~clk;
@@ -15,7 +17,7 @@ module tb_ntt_axi_wrapper;
     end
     
     // AXI-BRAM interface signals
-    logic [7:0]  axi_bram_addr;
+    logic [9:0]  axi_bram_addr;     // [9:8] bank, [7:0] coefficient
     logic [11:0] axi_bram_din;
     logic [11:0] axi_bram_dout;
     logic        axi_bram_we;
@@ -23,6 +25,11 @@ module tb_ntt_axi_wrapper;
 
     logic        irq;
 
+    // Performance counters, selected and read through the S00_AXI control slave
+    logic [4:0]  perf_sel;
+    logic        perf_clear;
+    logic [31:0] perf_data;
+
     // DUT
     NTT_AXI_wrapper dut (
         .clk(clk),
@@ -35,21 +42,111 @@ module tb_ntt_axi_wrapper;
         .irq(irq),
         .start(start),
         .mode(mode),
-        .done(done)
+        .count(count),
+        .done(done),
+        .busy(busy),
+        .start_dropped(start_dropped),
+        .perf_sel(perf_sel),
+        .perf_clear(perf_clear),
+        .perf_data(perf_data)
     );
 
 
+    // AXI-Lite control slave of the packaged IP: slv_reg2 (0x08) selects the counter
+    // ([4:0], bit 4 = free-running bank) and clears the totals ([31]), slv_reg3 (0x0C)
+    // returns the selected counter. Start/mode stay driven directly above.
+    localparam logic [3:0] REG_STATUS    = 4'h4;   // [0] done, [1] busy, [2] start dropped
+    localparam logic [3:0] REG_PERF_CTRL = 4'h8;
+    localparam logic [3:0] REG_PERF_DATA = 4'hC;
+    localparam logic [31:0] PERF_CLEAR   = 32'h8000_0000;
+
+    logic [3:0]  s_awaddr = '0, s_araddr = '0;
+    logic [31:0] s_wdata = '0, s_rdata;
+    logic        s_awvalid = 0, s_wvalid = 0, s_bready = 0, s_arvalid = 0, s_rready = 0;
+    logic        s_awready, s_wready, s_bvalid, s_arready, s_rvalid;
+    logic [1:0]  s_bresp, s_rresp;
+
+    AXI_NTT_UNIT_v1_0_S00_AXI #(
+        .C_S_AXI_DATA_WIDTH(32),
+        .C_S_AXI_ADDR_WIDTH(4)
+    ) ctrl_slave (
+        .ntt_start_o(),
+        .ntt_mode_o(),
+        .ntt_count_o(),
+        .ntt_scheme_o(),
+        .ntt_int_clear(),
+        .ntt_done_i(irq),
+        .ntt_busy_i(busy),
+        .ntt_error_i(start_dropped),
+        .ntt_dual_i(1'b0),              // Kyber-only DUT
+        .perf_sel_o(perf_sel),
+        .perf_clear_o(perf_clear),
+        .perf_data_i(perf_data),
+        .S_AXI_ACLK(clk),
+        .S_AXI_ARESETN(~rst),
+        .S_AXI_AWADDR(s_awaddr),
+        .S_AXI_AWPROT(3'b000),
+        .S_AXI_AWVALID(s_awvalid),
+        .S_AXI_AWREADY(s_awready),
+        .S_AXI_WDATA(s_wdata),
+        .S_AXI_WSTRB(4'hF),
+        .S_AXI_WVALID(s_wvalid),
+        .S_AXI_WREADY(s_wready),
+        .S_AXI_BRESP(s_bresp),
+        .S_AXI_BVALID(s_bvalid),
+        .S_AXI_BREADY(s_bready),
+        .S_AXI_ARADDR(s_araddr),
+        .S_AXI_ARPROT(3'b000),
+        .S_AXI_ARVALID(s_arvalid),
+        .S_AXI_ARREADY(s_arready),
+        .S_AXI_RDATA(s_rdata),
+        .S_AXI_RRESP(s_rresp),
+        .S_AXI_RVALID(s_rvalid),
+        .S_AXI_RREADY(s_rready)
+    );
+
+    // one AXI-Lite write, address and data together like the PS does
+    task automatic axil_write(input logic [3:0] addr, input logic [31:0] data);
+        @(negedge clk);
+        s_awaddr = addr; s_wdata = data;
+        s_awvalid = 1'b1; s_wvalid = 1'b1; s_bready = 1'b1;
+        do @(negedge clk); while (!(s_awready && s_wready));
+        @(negedge clk);
+        s_awvalid = 1'b0; s_wvalid = 1'b0;
+        while (!s_bvalid) @(negedge clk);
+        @(negedge clk);
+        s_bready = 1'b0;
+    endtask
+
+    task automatic axil_read(input logic [3:0] addr, output logic [31:0] data);
+        @(negedge clk);
+        s_araddr = addr;
+        s_arvalid = 1'b1; s_rready = 1'b1;
+        do @(negedge clk); while (!s_arready);
+        @(negedge clk);
+        s_arvalid = 1'b0;
+        while (!s_rvalid) @(negedge clk);
+        data = s_rdata;
+        @(negedge clk);
+        s_rready = 1'b0;
+    endtask
+
     // Storage for input/output
     logic [11:0] original_poly [0:255];
     logic [11:0] output_poly   [0:255];
+    logic [11:0] ntt_ref       [0:255];     // forward transform of original_poly
+    logic [11:0] vec_in        [0:3][0:255];
 
-    // Burst write: writes 256 coefficients, one per clock
-    task automatic axi_write(input [11:0] data_in [0:255]);
+    int irq_count = 0;
+    always @(posedge clk) if (irq) irq_count++;
+
+    // Burst write: writes 256 coefficients of one bank, one per clock
+    task automatic axi_write(input [11:0] data_in [0:255], input int bank = 0);
         axi_bram_en = 1'b1;
         axi_bram_we = 1'b1;
     
         for (int i = 0; i < 256; i++) begin
-            axi_bram_addr = i[7:0];
+            axi_bram_addr = {bank[1:0], i[7:0]};
             axi_bram_din  = data_in[i];
             @(posedge clk);  // one coefficient per clock
         end
@@ -59,10 +156,10 @@ module tb_ntt_axi_wrapper;
     endtask
     
     // Burst read for 256 sequential coefficients
-    task automatic axi_read(output [11:0] data_out [0:255]);
+    task automatic axi_read(output [11:0] data_out [0:255], input int bank = 0);
         axi_bram_en = 1'b1;
         for (int i = 0; i < 257; i++) begin
-            axi_bram_addr = i[7:0];
+            axi_bram_addr = {bank[1:0], i[7:0]};
             @(posedge clk);
             if (i > 0) data_out[i-1] = axi_bram_dout;
         end
@@ -72,6 +169,85 @@ module tb_ntt_axi_wrapper;
     
     
 
+    // Counter indices, see NTT_perf_counters
+    localparam int PERF_BUSY      = 0;
+    localparam int PERF_STAGE0    = 1;
+    localparam int PERF_FLUSH     = 9;
+    localparam int PERF_INTT_WAIT = 10;
+    localparam int PERF_ISSUE     = 11;
+    localparam int PERF_CONFLICT  = 12;
+    localparam int PERF_JOBS      = 13;
+    localparam int PERF_TOTAL     = 16;   // sel[4]: free-running bank
+
+    int perf_errors = 0;
+    logic [31:0] perf [0:31];   // both banks as read through the register port
+
+    // same sequence as NttPerf_ReadCounter: select in slv_reg2, read slv_reg3
+    task automatic perf_snapshot();
+        logic [31:0] ctrl;
+        for (int i = 0; i < 32; i++) begin
+            axil_write(REG_PERF_CTRL, 32'(i));
+            axil_read(REG_PERF_DATA, perf[i]);
+        end
+        axil_read(REG_PERF_CTRL, ctrl);
+        if (ctrl != 32'd31 || perf_sel != 5'd31) begin
+            $error("slv_reg2 reads back %0h, select %0d", ctrl, perf_sel);
+            perf_errors++;
+        end
+    endtask
+
+    // checks the job snapshot of the last command (polys transforms back to back)
+    task automatic perf_check(input bit inverse, input int polys = 1);
+        int stage_sum;
+        perf_snapshot();
+        stage_sum = 0;
+        for (int s = 0; s < 8; s++) begin
+            if (perf[PERF_STAGE0 + s] < 128 * polys) begin
+                $error("stage %0d: %0d cycles for %0d butterflies", s, perf[PERF_STAGE0 + s], 128 * polys);
+                perf_errors++;
+            end
+            stage_sum += perf[PERF_STAGE0 + s];
+        end
+        $display("  busy %0d, stages %0d, flush %0d, intt_wait %0d, issued %0d, conflicts %0d",
+                 perf[PERF_BUSY], stage_sum, perf[PERF_FLUSH], perf[PERF_INTT_WAIT],
+                 perf[PERF_ISSUE], perf[PERF_CONFLICT]);
+        if (perf[PERF_ISSUE] != 8 * 128 * polys) begin
+            $error("expected %0d butterfly issues", 8 * 128 * polys);
+            perf_errors++;
+        end
+        // every busy cycle is a stage, a stall, a DONE cycle or the IDLE cycle
+        // between two polynomials of a vector
+        if (perf[PERF_BUSY] != stage_sum + perf[PERF_FLUSH] + perf[PERF_INTT_WAIT] + 2 * polys - 1) begin
+            $error("busy cycles do not add up");
+            perf_errors++;
+        end
+        if ((perf[PERF_INTT_WAIT] != 0) != inverse || perf[PERF_CONFLICT] != 0 ||
+            perf[PERF_JOBS] != 1) begin
+            $error("unexpected stall/conflict/job counts");
+            perf_errors++;
+        end
+    endtask
+
+    // One vector command over banks 0..polys-1 with a single completion interrupt
+    task automatic vector_run(input bit inverse, input int polys);
+        int irqs_before;
+        irqs_before = irq_count;
+        @(posedge clk);
+        start = 1'b1; mode = inverse; count = polys[2:0];
+        @(posedge clk);
+        start = 1'b0; mode = 1'b0; count = 3'd0;
+        wait(irq);
+        @(posedge clk);
+        // the controller must be back in IDLE with no further interrupt
+        repeat (20) @(posedge clk);
+        $display("[%0t] %s of %0d polynomials done.", $time, inverse ? "INTT" : "NTT", polys);
+        if (irq_count - irqs_before != 1) begin
+            $error("%0d interrupts for one vector command", irq_count - irqs_before);
+            perf_errors++;
+        end
+        perf_check(inverse, polys);
+    endtask
+
     // ----------------------------------------------------------------
     // STIMULUS
     // ----------------------------------------------------------------
@@ -99,6 +275,9 @@ module tb_ntt_axi_wrapper;
         // Wait for done
         wait(irq);
         $display("[%0t] NTT done.", $time);
+        @(posedge clk);
+        perf_check(1'b0);
+        axi_read(ntt_ref);
         
         // Start INTT
         #20;
@@ -106,6 +285,24 @@ module tb_ntt_axi_wrapper;
         start = 1'b0; mode = 1'b0;
         wait(irq);
         $display("[%0t] INTT done.", $time);
+        @(posedge clk);
+        perf_check(1'b1);
+        if (perf[PERF_TOTAL + PERF_JOBS] != 2) begin
+            $error("free-running bank should have counted 2 jobs");
+            perf_errors++;
+        end
+        // NttPerf_ClearTotals: set and release bit 31 of slv_reg2
+        axil_write(REG_PERF_CTRL, PERF_CLEAR);
+        if (!perf_clear) begin
+            $error("slv_reg2[31] does not drive the counter clear");
+            perf_errors++;
+        end
+        axil_write(REG_PERF_CTRL, 32'd0);
+        perf_snapshot();
+        if (perf[PERF_TOTAL + PERF_BUSY] != 0 || perf[PERF_JOBS] != 1) begin
+            $error("clear must reset the free-running bank only");
+            perf_errors++;
+        end
         
         // Read back results
         $display("[%0t] DMA Reading back polynomial...", $time);
@@ -119,7 +316,87 @@ module tb_ntt_axi_wrapper;
             end
         end
 
+        // ------------------------------------------------------------
+        // Vector command: banks 0..k-1 in one start, one IRQ
+        // ------------------------------------------------------------
+        for (int b = 0; b < 4; b++)
+            for (int i = 0; i < 256; i++)
+                vec_in[b][i] = (b == 2) ? original_poly[i] : 12'((i * 13 + b * 1000 + 7) % 3329);
+        for (int b = 0; b < 4; b++) axi_write(vec_in[b], b);
+
+        // k = 3: bank 2 holds original_poly, bank 3 must stay untouched
+        vector_run(1'b0, 3);
+        axi_read(output_poly, 2);
+        for (int i = 0; i < 256; i++)
+            if (output_poly[i] !== ntt_ref[i])
+                $error("bank 2 NTT mismatch at %0d: expected %0d, got %0d", i, ntt_ref[i], output_poly[i]);
+        axi_read(output_poly, 3);
+        for (int i = 0; i < 256; i++)
+            if (output_poly[i] !== vec_in[3][i])
+                $error("bank 3 modified by a 3-polynomial command at %0d", i);
+        vector_run(1'b1, 3);
+
+        // k = 4 and k = 2 round trips
+        vector_run(1'b0, 4);
+        vector_run(1'b1, 4);
+        vector_run(1'b0, 2);
+        vector_run(1'b1, 2);
+
+        // START while a vector runs: ignored, BUSY and ERROR readable, still one IRQ
+        begin
+            logic [31:0] st;
+            int irqs_before;
+            irqs_before = irq_count;
+            @(posedge clk);
+            start = 1'b1; mode = 1'b0; count = 3'd2;
+            @(posedge clk);
+            start = 1'b0; count = 3'd0;
+            repeat (50) @(posedge clk);
+            axil_read(REG_STATUS, st);
+            if (st[2:1] != 2'b01) begin
+                $error("status %0b while running, expected busy only", st[2:0]);
+                perf_errors++;
+            end
+            start = 1'b1; mode = 1'b1;      // dropped: inverse must not run
+            @(posedge clk);
+            start = 1'b0; mode = 1'b0;
+            axil_read(REG_STATUS, st);
+            if (st[2:1] != 2'b11) begin
+                $error("status %0b after a start while busy, expected busy and error", st[2:0]);
+                perf_errors++;
+            end
+            wait(irq);
+            repeat (20) @(posedge clk);
+            axil_read(REG_STATUS, st);
+            if (irq_count - irqs_before != 1 || st[2:1] != 2'b10) begin
+                $error("%0d interrupts, status %0b after a dropped start", irq_count - irqs_before, st[2:0]);
+                perf_errors++;
+            end
+            // the forward pass above ran once, the round trip restores banks 0 and 1
+            vector_run(1'b1, 2);
+            axil_read(REG_STATUS, st);
+            if (st[2]) begin
+                $error("error flag not cleared by an accepted start");
+                perf_errors++;
+            end
+        end
+
+        for (int b = 0; b < 4; b++) begin
+            axi_read(output_poly, b);
+            for (int i = 0; i < 256; i++)
+                if (output_poly[i] !== vec_in[b][i]) begin
+                    $error("bank %0d round trip mismatch at %0d: expected %0d, got %0d",
+                           b, i, vec_in[b][i], output_poly[i]);
+                    break;
+                end
+        end
+
+        if (perf_errors == 0)
+            $display("Performance counters OK (read through S00_AXI slv_reg2/slv_reg3).");
+        else
+            $display("TEST FAILED: %0d performance counter errors", perf_errors);
         $display("NTT + INTT test passed through AXI wrapper.");
+        $display("Vector command test done (k = 2, 3, 4).");
         $finish;
     end
 
@@ -0,0 +1,212 @@
+`timescale 1ns / 1ps
+
+// Streams NUM_POLYS polynomials back to back through Streaming_NTT, checks every output
+// and chains a Streaming INTT behind it to check the round trip.
+// The first VECTOR_POLYS come from the C reference ("Test software C code": make gen_ntt_vectors
+// && ./gen_ntt_vectors <dir>, then point VECTOR_DIR at <dir>) and are checked against its
+// kyber_ntt.mem; the rest are random and checked against a direct port of ntt_standard(),
+// which is itself checked against the vectors first. One idle gap sits between two
+// polynomials, as the stages allow.
+// P and MUL_LATENCY can be overridden from the simulator (run_sim.sh tb_Streaming_NTT -- P=1);
+// run_streaming_sweep.sh runs every P and MUL_LATENCY. With P = 4 and MUL_LATENCY = 3 the
+// stages with D = 32, 16, 8 run as delay-feedback loops and D = 4, 2, 1 as feed-forward
+// delay lines, P = 1 adds D = 128, 64.
+module tb_Streaming_NTT #(
+    parameter int    P           = 4,
+    parameter int    MUL_LATENCY = 3,
+    parameter string VECTOR_DIR  = "."
+);
+
+    localparam int N          = 256;
+    localparam int DATA_WIDTH = 12;
+    localparam int Q          = 3329;
+    localparam int NUM_POLYS  = 8;
+    localparam int VECTOR_POLYS = 4;    // polynomials in gen_ntt_vectors' .mem files
+    localparam int GAP_AFTER  = 5;      // polynomial followed by 3 idle cycles
+    localparam int BEATS      = N / P;
+
+    logic clk, rst;
+
+    logic                  valid_in;
+    logic [DATA_WIDTH-1:0] data_in  [0:P-1];
+    logic                  ntt_valid, intt_valid;
+    logic [DATA_WIDTH-1:0] ntt_out  [0:P-1];
+    logic [DATA_WIDTH-1:0] intt_out [0:P-1];
+
+    Streaming_NTT #(.N(N), .P(P), .INVERSE(1'b0), .DATA_WIDTH(DATA_WIDTH), .MUL_LATENCY(MUL_LATENCY)) dut_ntt (
+        .clk(clk), .rst(rst),
+        .valid_in(valid_in), .data_in(data_in),
+        .valid_out(ntt_valid), .data_out(ntt_out)
+    );
+
+    Streaming_NTT #(.N(N), .P(P), .INVERSE(1'b1), .DATA_WIDTH(DATA_WIDTH), .MUL_LATENCY(MUL_LATENCY)) dut_intt (
+        .clk(clk), .rst(rst),
+        .valid_in(ntt_valid), .data_in(ntt_out),
+        .valid_out(intt_valid), .data_out(intt_out)
+    );
+
+    // Clock
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    // ---------------------------------------------------------------- C reference
+    function automatic int bit_reverse(int x, int log_n);
+        int r = 0;
+        for (int i = 0; i < log_n; i++) begin
+            r = (r << 1) | (x & 1);
+            x = x >> 1;
+        end
+        return r;
+    endfunction
+
+    function automatic int mod_pow(int base, int e);
+        longint r = 1, b = base;
+        while (e) begin
+            if (e & 1) r = (r * b) % Q;
+            b = (b * b) % Q;
+            e = e >> 1;
+        end
+        return int'(r);
+    endfunction
+
+    function automatic int mod_div2(int a);
+        return (a % 2 == 0) ? a / 2 : 1664 + (a + 1) / 2;
+    endfunction
+
+    task automatic ref_transform(inout int a [0:N-1], input bit inverse);
+        int zetas [0:N/2-1];
+        int omega = inverse ? 3040 : 910;
+        for (int i = 0; i < N/2; i++) zetas[i] = mod_pow(omega, bit_reverse(i, $clog2(N) - 1));
+
+        for (int s = 0; s < $clog2(N); s++) begin
+            int len  = inverse ? (1 << s) : (N >> (s + 1));
+            int step = N / (2 * len);
+            for (int start = 0; start < N; start += 2 * len) begin
+                for (int j = 0; j < len; j++) begin
+                    int u = a[start + j];
+                    int v = a[start + j + len];
+                    int w = zetas[j * step];
+                    if (!inverse) begin
+                        v = (v * w) % Q;
+                        a[start + j]       = (u + v) % Q;
+                        a[start + j + len] = (u - v + Q) % Q;
+                    end else begin
+                        a[start + j]       = mod_div2((u + v) % Q);
+                        a[start + j + len] = mod_div2((((u - v + Q) % Q) * w) % Q);
+                    end
+                end
+            end
+        end
+    endtask
+
+    // ---------------------------------------------------------------- stimulus / checking
+    int polys    [NUM_POLYS][0:N-1];
+    int expected [NUM_POLYS][0:N-1];
+    logic [DATA_WIDTH-1:0] vec_in  [0:VECTOR_POLYS*N-1];
+    logic [DATA_WIDTH-1:0] vec_ntt [0:VECTOR_POLYS*N-1];
+    int errors = 0;
+    int ntt_beat = 0, intt_beat = 0;
+    int cycle = 0, first_in_cycle = 0, last_out_cycle = 0;
+
+    always @(posedge clk) cycle <= cycle + 1;
+
+    // forward outputs
+    always @(posedge clk) begin
+        if (!rst && ntt_valid) begin
+            for (int l = 0; l < P; l++) begin
+                int idx = (ntt_beat % BEATS) * P + l;
+                int p   = ntt_beat / BEATS;
+                if (ntt_out[l] !== expected[p][idx]) begin
+                    if (errors < 10)
+                        $display("NTT MISMATCH poly %0d coeff %0d: got %0d expected %0d",
+                                 p, idx, ntt_out[l], expected[p][idx]);
+                    errors++;
+                end
+            end
+            ntt_beat++;
+        end
+    end
+
+    // round trip outputs
+    always @(posedge clk) begin
+        if (!rst && intt_valid) begin
+            for (int l = 0; l < P; l++) begin
+                int idx = (intt_beat % BEATS) * P + l;
+                int p   = intt_beat / BEATS;
+                if (intt_out[l] !== polys[p][idx]) begin
+                    if (errors < 10)
+                        $display("INTT MISMATCH poly %0d coeff %0d: got %0d expected %0d",
+                                 p, idx, intt_out[l], polys[p][idx]);
+                    errors++;
+                end
+            end
+            intt_beat++;
+            last_out_cycle = cycle;
+        end
+    end
+
+    initial begin
+        rst = 1;
+        valid_in = 0;
+        for (int l = 0; l < P; l++) data_in[l] = '0;
+
+        $readmemh({VECTOR_DIR, "/kyber_in.mem"}, vec_in);
+        $readmemh({VECTOR_DIR, "/kyber_ntt.mem"}, vec_ntt);
+        for (int p = 0; p < NUM_POLYS; p++) begin
+            for (int i = 0; i < N; i++) begin
+                polys[p][i]    = (p < VECTOR_POLYS) ? vec_in[p * N + i] : $urandom % Q;
+                expected[p][i] = polys[p][i];
+            end
+            ref_transform(expected[p], 1'b0);
+            if (p < VECTOR_POLYS) begin
+                for (int i = 0; i < N; i++) begin
+                    if (vec_ntt[p * N + i] !== expected[p][i]) begin
+                        if (errors < 10)
+                            $display("ERROR: reference port disagrees with kyber_ntt.mem, poly %0d coeff %0d: %0d, file %0d",
+                                     p, i, expected[p][i], vec_ntt[p * N + i]);
+                        errors++;
+                    end
+                    expected[p][i] = vec_ntt[p * N + i];
+                end
+            end
+        end
+
+        repeat (4) @(posedge clk);
+        rst = 0;
+        repeat (4) @(posedge clk);   // let the butterfly mode pipelines settle
+
+        // back-to-back polynomials, one beat per clock, one gap of 3 idle cycles
+        first_in_cycle = cycle;
+        for (int p = 0; p < NUM_POLYS; p++) begin
+            for (int b = 0; b < BEATS; b++) begin
+                @(negedge clk);
+                valid_in = 1;
+                for (int l = 0; l < P; l++) data_in[l] = polys[p][b * P + l];
+            end
+            if (p == GAP_AFTER) begin
+                @(negedge clk);
+                valid_in = 0;
+                repeat (2) @(negedge clk);
+            end
+        end
+        @(negedge clk);
+        valid_in = 0;
+
+        wait (intt_beat == NUM_POLYS * BEATS);
+        repeat (4) @(posedge clk);
+
+        if (ntt_beat != NUM_POLYS * BEATS) begin
+            $display("ERROR: %0d NTT beats, expected %0d", ntt_beat, NUM_POLYS * BEATS);
+            errors++;
+        end
+
+        $display("P = %0d: %0d polynomials, %0d cycles from first input to last round-trip output",
+                 P, NUM_POLYS, last_out_cycle - first_in_cycle);
+        $display("throughput: 1 polynomial every %0d cycles per direction", BEATS);
+
+        if (errors == 0) $display("TEST PASSED");
+        else             $display("TEST FAILED: %0d errors", errors);
+        $finish;
+    end
+
+endmodule